@@ -0,0 +1,71 @@
+#ifndef HH_BENCH_HELPER_HH
+#define HH_BENCH_HELPER_HH
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "phi_generator.h"
+#include "typedefs.h"
+#include "weight_grid.h"
+
+using namespace Eigen;
+using namespace std;
+
+// nodes per layer of the networks the benchmarks run on, selected by the layer_shape argument of a benchmark
+// the first is the three layer problem and the second the four layer problem
+const vector<vector<Index>> bench_layer_shapes = {{3, 4, 1}, {24, 128, 64, 12}};
+
+inline weightType benchWeights(const unsigned int& layer_shape)
+{
+    const vector<Index>& nodes = bench_layer_shapes[layer_shape];
+    weightType weights;
+    for (unsigned int l = 0; l + 1 < nodes.size(); l++)
+    {
+        weights.push_back(MatrixXd::Random(nodes[l], nodes[l+1]));
+    }
+    return weights;
+}
+
+// random training data with one row per phi
+inline vector<MatrixXd> benchData(const unsigned int& layer_shape, const unsigned int& num_phis)
+{
+    const vector<Index>& nodes = bench_layer_shapes[layer_shape];
+    MatrixXd input = MatrixXd::Random(num_phis, nodes.front());
+    MatrixXd target = (MatrixXd::Random(num_phis, nodes.back()).array() + 1.0) / 2.0;
+    return {input, target};
+}
+
+// one phi per training row on each level, which is the serialized training the drivers use
+inline vector<vector<phiFuncType>> benchPhis(const unsigned int& layer_shape, const unsigned int& num_phis, const unsigned int& max_level)
+{
+    vector<MatrixXd> data = benchData(layer_shape, num_phis);
+    return generatePhis(data[0], data[1], 0.1, 30.0, max_level, 1);
+}
+
+// the same phis as benchPhis as the concrete propagators of the given nn type
+template <typename Network>
+vector<TrainingPropagator<Network>> benchPropagators(const unsigned int& layer_shape, const unsigned int& num_phis, const unsigned int& max_level)
+{
+    vector<MatrixXd> data = benchData(layer_shape, num_phis);
+    return generatePropagators<Network>(data[0], data[1], 0.1, 30.0, max_level, 1);
+}
+
+// a grid of num_steps random time steps
+inline WeightGrid benchGrid(const unsigned int& layer_shape, const unsigned int& num_steps)
+{
+    listOfWeights weights(num_steps);
+    for (weightType& step : weights)
+    {
+        step = benchWeights(layer_shape);
+    }
+    return WeightGrid(weights);
+}
+
+// report the number of time steps each iteration processes, so that grids of different sizes can be compared
+inline void setStepsProcessed(benchmark::State& state, const unsigned int& num_steps)
+{
+    state.SetItemsProcessed(state.iterations() * num_steps);
+}
+
+#endif
\ No newline at end of file
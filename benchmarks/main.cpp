@@ -0,0 +1,9 @@
+#include "benchmark/benchmark.h"
+
+int main(int argc, char **argv) 
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {return 1;}
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
\ No newline at end of file
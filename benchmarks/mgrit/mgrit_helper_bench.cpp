@@ -0,0 +1,48 @@
+#include "benchmark/benchmark.h"
+#include "mgrit_helper.h"
+#include "../bench_helper.h"
+
+// arguments: layer shape, number of time steps N
+static void BM_MGRITHelperEuclideanNorm(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    MGRITHelper helper(benchPhis(state.range(0), num_steps - 1, 1)[0]);
+    const WeightGrid weights = benchGrid(state.range(0), num_steps);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(helper.euclideanNorm(weights));
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_MGRITHelperEuclideanNorm)->ArgNames({"layer_shape", "N"})->Args({0, 128})->Args({1, 128});
+
+// arguments: layer shape, number of time steps N
+static void BM_MGRITHelperForwardSolve(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    MGRITHelper helper(benchPhis(state.range(0), num_steps - 1, 1)[0]);
+    const WeightGrid rhs = benchGrid(state.range(0), num_steps);
+    WeightGrid result(num_steps, rhs.getLayout());
+    for (auto _ : state)
+    {
+        helper.forwardSolve(rhs, result);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_MGRITHelperForwardSolve)->ArgNames({"layer_shape", "N"})->Args({0, 128})->Args({1, 32});
+
+// arguments: layer shape, number of time steps N, number of threads
+static void BM_MGRITHelperResidual(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    MGRITHelper helper(benchPhis(state.range(0), num_steps - 1, 1)[0], state.range(2));
+    const WeightGrid weights = benchGrid(state.range(0), num_steps);
+    const WeightGrid rhs = benchGrid(state.range(0), num_steps);
+    WeightGrid result(num_steps, rhs.getLayout());
+    for (auto _ : state)
+    {
+        helper.residual(weights, rhs, result);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_MGRITHelperResidual)->ArgNames({"layer_shape", "N", "threads"})->Args({0, 128, 1})->Args({0, 128, 4})->Args({1, 32, 1})->Args({1, 32, 4})->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <cmath>
+
+#include "benchmark/benchmark.h"
+#include "fixed_neural_network.h"
+#include "mgrit_solver.h"
+#include "neural_network.h"
+#include "training_propagator.h"
+#include "../bench_helper.h"
+
+// times runs of the given solver to the same tolerance, starting from random weights at the first time step
+template <typename Solver>
+void runSolver(benchmark::State& state, Solver& solver, const unsigned int& layer_shape, const unsigned int& N, const bool& f_cycle)
+{
+    weightType initial_step = benchWeights(layer_shape);
+    listOfWeights initial_weights(N + 1, initial_step);
+    for (unsigned int i = 1; i <= N; i++)
+    {
+        for (MatrixXd& layer : initial_weights[i]) {layer.setZero();}
+    }
+    const WeightGrid rhs(initial_weights);
+
+    for (auto _ : state)
+    {
+        WeightGrid weights(initial_weights);
+        solver.run(weights, rhs, pow(10, -9) * sqrt(N + 1), f_cycle);
+        benchmark::DoNotOptimize(weights.step(N).data());
+    }
+    setStepsProcessed(state, N + 1);
+}
+
+// solves the training problem of the drivers with the type-erased phis
+// arguments: layer shape, number of time steps N, coarsening factor m, max level, 1 for F-cycles or 0 for V-cycles
+static void BM_MGRITSolverRun(benchmark::State& state)
+{
+    const unsigned int N = state.range(1);
+    const unsigned int max_level = state.range(3);
+    MGRITSolver solver(state.range(2), benchPhis(state.range(0), N, max_level), max_level);
+    runSolver(state, solver, state.range(0), N, state.range(4));
+}
+BENCHMARK(BM_MGRITSolverRun)->ArgNames({"layer_shape", "N", "m", "max_level", "f_cycle"})
+                            ->Args({0, 100, 2, 2, 1})
+                            ->Args({0, 100, 2, 10, 1})
+                            ->Args({0, 100, 2, 10, 0})
+                            ->Args({0, 400, 4, 4, 1})
+                            ->Args({1, 32, 2, 3, 1})
+                            ->Unit(benchmark::kMillisecond);
+
+// solves the same problem with the solver instantiated on the propagator of the given nn type, which the solver
+// applies without type erasure - the fixed-size nn only fits the three layer problem
+template <typename Network>
+static void BM_MGRITSolverRunPropagator(benchmark::State& state)
+{
+    const unsigned int N = state.range(1);
+    const unsigned int max_level = state.range(3);
+    BasicMGRITSolver<TrainingPropagator<Network>> solver(state.range(2), benchPropagators<Network>(state.range(0), N, max_level), max_level);
+    runSolver(state, solver, state.range(0), N, state.range(4));
+}
+BENCHMARK_TEMPLATE(BM_MGRITSolverRunPropagator, NeuralNetwork)->ArgNames({"layer_shape", "N", "m", "max_level", "f_cycle"})
+                                                              ->Args({0, 100, 2, 10, 1})
+                                                              ->Args({0, 400, 4, 4, 1})
+                                                              ->Args({1, 32, 2, 3, 1})
+                                                              ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MGRITSolverRunPropagator, FixedNeuralNetwork<3, 4, 1>)->ArgNames({"layer_shape", "N", "m", "max_level", "f_cycle"})
+                                                                            ->Args({0, 100, 2, 10, 1})
+                                                                            ->Args({0, 400, 4, 4, 1})
+                                                                            ->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "benchmark/benchmark.h"
+#include "move_grids.h"
+#include "../bench_helper.h"
+
+// arguments: layer shape, number of time steps N, coarsening factor m
+static void BM_MoveGridsProject(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    const unsigned int m = state.range(2);
+    MoveGrids mover(m);
+    WeightGrid fine_grid = benchGrid(state.range(0), num_steps);
+    const WeightGrid error = benchGrid(state.range(0), (num_steps + m - 1) / m);
+    for (auto _ : state)
+    {
+        mover.project(fine_grid, error);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_MoveGridsProject)->ArgNames({"layer_shape", "N", "m"})->Args({0, 128, 2})->Args({1, 128, 2});
+
+// restricting only creates a view, so the benchmark includes the copy the solver makes of the coarse weights
+// arguments: layer shape, number of time steps N, coarsening factor m
+static void BM_MoveGridsRestrict(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    MoveGrids mover(state.range(2));
+    WeightGrid fine_grid = benchGrid(state.range(0), num_steps);
+    for (auto _ : state)
+    {
+        WeightGrid coarse_grid = mover.restrict(fine_grid);
+        WeightGrid coarse_copy = coarse_grid;
+        benchmark::DoNotOptimize(coarse_copy.step(0).data());
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_MoveGridsRestrict)->ArgNames({"layer_shape", "N", "m"})->Args({0, 128, 2})->Args({1, 128, 2});
\ No newline at end of file
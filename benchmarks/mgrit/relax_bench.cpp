@@ -0,0 +1,48 @@
+#include "benchmark/benchmark.h"
+#include "relax.h"
+#include "../bench_helper.h"
+
+// arguments: layer shape, number of time steps N, coarsening factor m
+static void BM_RelaxCRelax(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    Relax relaxer(state.range(2), benchPhis(state.range(0), num_steps - 1, 1)[0]);
+    WeightGrid weights = benchGrid(state.range(0), num_steps);
+    const WeightGrid rhs = weights;
+    for (auto _ : state)
+    {
+        relaxer.cRelax(weights, rhs);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_RelaxCRelax)->ArgNames({"layer_shape", "N", "m"})->Args({0, 128, 2})->Args({0, 128, 8})->Args({1, 32, 2});
+
+// arguments: layer shape, number of time steps N, coarsening factor m
+static void BM_RelaxFCFRelax(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    Relax relaxer(state.range(2), benchPhis(state.range(0), num_steps - 1, 1)[0]);
+    WeightGrid weights = benchGrid(state.range(0), num_steps);
+    const WeightGrid rhs = weights;
+    for (auto _ : state)
+    {
+        relaxer.fcfRelax(weights, rhs);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_RelaxFCFRelax)->ArgNames({"layer_shape", "N", "m"})->Args({0, 128, 2})->Args({0, 128, 8})->Args({1, 32, 2});
+
+// arguments: layer shape, number of time steps N, coarsening factor m
+static void BM_RelaxFRelax(benchmark::State& state)
+{
+    const unsigned int num_steps = state.range(1) + 1;
+    Relax relaxer(state.range(2), benchPhis(state.range(0), num_steps - 1, 1)[0]);
+    WeightGrid weights = benchGrid(state.range(0), num_steps);
+    const WeightGrid rhs = weights;
+    for (auto _ : state)
+    {
+        relaxer.fRelax(weights, rhs);
+    }
+    setStepsProcessed(state, num_steps);
+}
+BENCHMARK(BM_RelaxFRelax)->ArgNames({"layer_shape", "N", "m"})->Args({0, 128, 2})->Args({0, 128, 8})->Args({1, 32, 2});
\ No newline at end of file
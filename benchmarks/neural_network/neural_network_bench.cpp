@@ -0,0 +1,50 @@
+#include "benchmark/benchmark.h"
+#include "fixed_neural_network.h"
+#include "neural_network.h"
+#include "../bench_helper.h"
+
+// arguments: layer shape, number of rows per training step
+static void BM_NeuralNetworkTrain(benchmark::State& state)
+{
+    const unsigned int layer_shape = state.range(0);
+    const vector<Index>& nodes = bench_layer_shapes[layer_shape];
+    MatrixXd input = MatrixXd::Random(state.range(1), nodes.front());
+    MatrixXd target = MatrixXd::Ones(state.range(1), nodes.back());
+    NeuralNetwork nn(0.1, benchWeights(layer_shape));
+    for (auto _ : state)
+    {
+        nn.train(input, target);
+    }
+    setStepsProcessed(state, 1);
+}
+BENCHMARK(BM_NeuralNetworkTrain)->ArgNames({"layer_shape", "rows"})->Args({0, 1})->Args({0, 4})->Args({1, 1})->Args({1, 64});
+
+// arguments: layer shape, number of rows per training step
+static void BM_NeuralNetworkPropagate(benchmark::State& state)
+{
+    const unsigned int layer_shape = state.range(0);
+    const vector<Index>& nodes = bench_layer_shapes[layer_shape];
+    MatrixXd input = MatrixXd::Random(state.range(1), nodes.front());
+    MatrixXd target = MatrixXd::Ones(state.range(1), nodes.back());
+    weightType weights = benchWeights(layer_shape);
+    for (auto _ : state)
+    {
+        weights = NeuralNetwork::propagate(weights, input, target, 0.1);
+    }
+    setStepsProcessed(state, 1);
+}
+BENCHMARK(BM_NeuralNetworkPropagate)->ArgNames({"layer_shape", "rows"})->Args({0, 1})->Args({0, 4})->Args({1, 1})->Args({1, 64});
+
+// arguments: number of rows per training step
+static void BM_FixedNeuralNetworkPropagate(benchmark::State& state)
+{
+    MatrixXd input = MatrixXd::Random(state.range(0), 3);
+    MatrixXd target = MatrixXd::Ones(state.range(0), 1);
+    weightType weights = benchWeights(0);
+    for (auto _ : state)
+    {
+        weights = FixedNeuralNetwork<3, 4, 1>::propagate(weights, input, target, 0.1);
+    }
+    setStepsProcessed(state, 1);
+}
+BENCHMARK(BM_FixedNeuralNetworkPropagate)->ArgNames({"rows"})->Arg(1)->Arg(4);
\ No newline at end of file
@@ -0,0 +1,564 @@
+#ifndef HH_DISTRIBUTED_MGRIT_SOLVER_HH
+#define HH_DISTRIBUTED_MGRIT_SOLVER_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <Eigen/Dense>
+#include <iostream>
+#include <memory>
+#include <mpi.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mgrit_helper.h"
+#include "mgrit_solver.h"
+#include "move_grids.h"
+#include "propagator.h"
+#include "relax.h"
+#include "solver_stats.h"
+#include "thread_pool.h"
+#include "time_slabs.h"
+#include "typedefs.h"
+#include "weight_grid.h"
+
+using namespace Eigen;
+using namespace std;
+
+// applies a propagator to the time steps of a slab, where step i of the slab is step i + offset of the whole grid, so
+// that the helper classes relaxing the slab apply the same phi to each step as on the whole grid
+template <typename Propagator>
+class SlabPropagator {
+
+   private:
+
+      unsigned int offset;   // first time step of the slab on the whole grid
+      Propagator phi;        // propagator of the whole grid
+
+   public:
+
+      SlabPropagator(Propagator my_phi, unsigned int my_offset) : offset{my_offset}, 
+                                                                  phi{move(my_phi)}{}
+
+      void apply(unsigned int i, const weightType& weights, weightType& result) const
+      {
+         PropagatorTraits<Propagator>::apply(phi, i + offset, weights, result);
+      }
+
+      void apply(unsigned int i, const StepView& weights, weightType& result) const
+      {
+         PropagatorTraits<Propagator>::apply(phi, i + offset, weights, result);
+      }
+
+};
+
+// the slab of the finest level owned by one process together with the helper classes that relax it
+template <typename Propagator>
+struct SlabContext {
+
+   TimeSlabs slabs;                                                       // slabs of all processes
+   MoveGrids mover;                                                       // moves the weights of the slab to its C-points
+   BasicRelax<SlabPropagator<CountingPropagator<Propagator>>> relaxer;    // relaxes the weights of the slab
+
+};
+
+// the messages passing the last time step of a slab on to the next process, which needs it for the C-point at the start
+// of its own slab
+struct BoundaryExchange {
+
+   WeightGrid left;                // receives the last time step of the slab on the left
+   MPI_Request requests[2];        // the send to the next process and the receive from the previous one
+   WeightGrid right;               // copy of the last time step of the slab, so that the slab may change while it is sent
+
+};
+
+// the messages of the solver are matched by the order in which they are sent, so they all share one tag
+const int distributed_mgrit_tag = 0;
+
+// MGRIT on the processes of an MPI communicator, where each process owns a contiguous slab of the time points of the
+// finest level - the slabs start at C-points, so the F-relaxation stays local, and only the C-point at the start of a
+// slab needs the last time step of the slab before it, which is passed on by a message before the C-relaxation and
+// before the residual at that C-point is computed
+// by default the messages are overlapped with the relaxation, i.e. each process sends its last time step as soon as
+// it is relaxed and relaxes the rest of its slab before it waits for the step of the slab on its left
+// the coarse levels are m times smaller than the finest one, so they are agglomerated onto process 0, which solves them
+// with a BasicMGRITSolver on its threads, while the norms of the residual are summed up over all processes
+// every process of the communicator must construct the solver and call run with the same arguments, after MPI_Init
+template <typename Propagator>
+class BasicDistributedMGRITSolver {
+
+   private:
+
+      MPI_Comm comm;                            // communicator of the processes sharing the time points
+      bool display_stats;                       // displays stats about the MGRIT algorithm on process 0 as it is running
+      mutable shared_ptr<const SolverStats> last_stats;   // timings and counters of the last run of this process
+      unsigned int m;                           // coarsening factor
+      unsigned int max_level;                   // denotes the maximum coarse level grid MGRIT will recurse to
+      unsigned int num_ranks;                   // number of processes in the communicator
+      unsigned int num_threads;                 // number of threads the phi functions of each process are applied on
+      bool overlap;                             // relaxes the slab while the time step of the slab on its left is on its way
+      CountingPropagator<Propagator> phi;       // propagator of the finest level, which counts its applications
+      shared_ptr<ThreadPool> pool;              // worker pool relaxing the slab of this process and, on process 0, the coarse levels
+      unsigned int rank;                        // index of this process in the communicator
+      BasicMGRITSolver<Propagator> solver;      // solves the coarse levels agglomerated onto process 0
+
+      void cfRelax(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const;
+      void coarseCorrection(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& r1, const bool& f_cycle, SolverStats& stats) const;
+      bool finishExchange(const TimeSlabs& slabs, BoundaryExchange& exchange, weightType& phi_of_w, SolverStats& stats) const;
+      void fRelax(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const;
+      void gather(const TimeSlabs& slabs, const WeightGrid& local, WeightGrid& global) const;
+      double globalNorm(const WeightGrid& local) const;
+      void iteration(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, const bool& f_cycle, SolverStats& stats) const;
+      void scatter(const TimeSlabs& slabs, const WeightGrid& global, WeightGrid& local) const;
+      void startExchange(const WeightGrid& w0, BoundaryExchange& exchange, SolverStats& stats) const;
+
+   public:
+
+      BasicDistributedMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats = false, unsigned int my_num_threads = 1, MPI_Comm my_comm = MPI_COMM_WORLD);
+
+      // getters and setters
+      unsigned int getCoarseningFactor() const;
+      bool getDisplayStats() const;
+      unsigned int getMaxLevel() const;
+      unsigned int getNumRanks() const;
+      unsigned int getNumThreads() const;
+      bool getOverlap() const;
+      bool getPipelineCoarseSolve() const;
+      unsigned int getRank() const;
+      TimeSlabs getSlabs(unsigned int num_points) const;
+      SolverStats getStats() const;
+      void setDisplayStats(bool my_display_stats);
+      void setOverlap(bool my_overlap);
+      void setPipelineCoarseSolve(bool my_pipeline_coarse_solve);
+
+      // the first run takes the whole grid on every process and returns the whole solution on every process, the
+      // second one only the slab getSlabs(num_points) assigns to this process, so that no process holds the whole grid
+      // the stats of a run only cover the work done by this process, which includes the coarse levels on process 0
+      listOfWeights run(listOfWeights w0, const listOfWeights& rhs0, const double& tol, const bool& f_cycle) const;
+      SolverStats run(WeightGrid& w0, const WeightGrid& rhs0, unsigned int num_points, const double& tol, const bool& f_cycle) const;
+};
+
+// the distributed solver with a list of phi functions on each level, which can be built at run time
+typedef BasicDistributedMGRITSolver<vector<phiFuncType>> DistributedMGRITSolver;
+
+// the class template is implemented in the header, so that it can be instantiated on any propagator
+
+template <typename Propagator>
+BasicDistributedMGRITSolver<Propagator>::BasicDistributedMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats, unsigned int my_num_threads, MPI_Comm my_comm) : comm{my_comm}, 
+                                                                                                                                                                                                                display_stats{my_display_stats}, 
+                                                                                                                                                                                                                last_stats{make_shared<const SolverStats>()}, 
+                                                                                                                                                                                                                m{my_m}, 
+                                                                                                                                                                                                                max_level{my_max_level}, 
+                                                                                                                                                                                                                num_threads{my_num_threads}, 
+                                                                                                                                                                                                                overlap{true}, 
+                                                                                                                                                                                                                phi{my_phis[0]}, 
+                                                                                                                                                                                                                pool{make_shared<ThreadPool>(my_num_threads)}, 
+                                                                                                                                                                                                                solver{my_m, my_phis, my_max_level, false, pool}
+{
+   int comm_rank;
+   int comm_size;
+   MPI_Comm_rank(comm, &comm_rank);
+   MPI_Comm_size(comm, &comm_size);
+   rank = comm_rank;
+   num_ranks = comm_size;
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::cfRelax(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const
+{
+
+   // the C-point at the start of the slab needs the last time step of the slab on the left, which is on its way while
+   // the other C-points and F-intervals are relaxed
+   unsigned int num_intervals = r1.size();
+   BoundaryExchange c_exchange;
+   startExchange(w0, c_exchange, stats);
+   slab.relaxer.cRelax(w0, rhs0, 1, num_intervals);
+   slab.relaxer.fRelax(w0, rhs0, r1, 1, num_intervals);
+
+   // the last time step of the slab is final once its interval is relaxed, so it is passed on before this process waits
+   BoundaryExchange residual_exchange;
+   if (num_intervals > 1)
+   {
+      startExchange(w0, residual_exchange, stats);
+   }
+
+   // relax the first C-point and the first interval of the slab
+   weightType phi_of_w;
+   if (finishExchange(slab.slabs, c_exchange, phi_of_w, stats))
+   {
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         w0.layer(0, l) = phi_of_w[l] + rhs0.layer(0, l);
+      }
+   }
+   slab.relaxer.fRelax(w0, rhs0, r1, 0, 1);
+   if (num_intervals == 1)
+   {
+      startExchange(w0, residual_exchange, stats);
+   }
+
+   // the residual at the first C-point again needs the last time step of the slab on the left
+   if (finishExchange(slab.slabs, residual_exchange, phi_of_w, stats))
+   {
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         r1.layer(0, l) = rhs0.layer(0, l) - (w0.layer(0, l) - phi_of_w[l]);
+      }
+   }
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::coarseCorrection(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& r1, const bool& f_cycle, SolverStats& stats) const
+{
+
+   // gather the weights and the residual at the C-points of all slabs onto process 0
+   statsClock::time_point start = statsClock::now();
+   WeightGrid c_points = slab.mover.restrict(w0);  // get a view onto the coarse weights
+   WeightGrid w1 = c_points;  // copy them into a contiguous buffer that can be sent
+   unsigned int num_coarse_points = slab.slabs.coarseBegin(num_ranks-1) + slab.slabs.coarseSize(num_ranks-1);
+   WeightGrid global_w1;
+   WeightGrid global_r1;
+   if (rank == 0)
+   {
+      global_w1 = WeightGrid(num_coarse_points, w0.getLayout());
+      global_r1 = WeightGrid(num_coarse_points, w0.getLayout());
+   }
+   gather(slab.slabs, w1, global_w1);
+   gather(slab.slabs, r1, global_r1);
+   stats.levels[0].restrict_time += secondsSince(start);
+
+   // solve the coarse levels on process 0, while the other processes wait for their part of the correction
+   WeightGrid global_e1;
+   if (rank == 0)
+   {
+      solver.coarseCorrection(0, global_w1, global_r1, f_cycle, global_e1, stats);
+   }
+
+   // project the correction of each slab from the coarse level to its C-points
+   start = statsClock::now();
+   WeightGrid e1(w1.size(), w0.getLayout());
+   scatter(slab.slabs, global_e1, e1);
+   slab.mover.project(w0, e1);
+   stats.levels[0].project_time += secondsSince(start);
+}
+
+template <typename Propagator>
+bool BasicDistributedMGRITSolver<Propagator>::finishExchange(const TimeSlabs& slabs, BoundaryExchange& exchange, weightType& phi_of_w, SolverStats& stats) const
+{
+   // applies phi to the time step received from the previous process, which gives the phi of the time step before the
+   // first C-point of the slab - process 0 has no such step
+   statsClock::time_point start = statsClock::now();
+   MPI_Waitall(2, exchange.requests, MPI_STATUSES_IGNORE);
+   stats.levels[0].wait_time += secondsSince(start);
+   bool has_left_boundary = rank > 0;
+   if (has_left_boundary)
+   {
+      PropagatorTraits<CountingPropagator<Propagator>>::apply(phi, slabs.begin(rank) - 1, exchange.left.stepView(0), phi_of_w);
+   }
+   return has_left_boundary;
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::fRelax(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const
+{
+   // the relaxation of the slab computes the residual at all of its C-points except the first one, whose F-point before
+   // it lies in the slab on the left - the last interval is relaxed first, so that its last time step is on its way to
+   // the next process while the other intervals are relaxed
+   unsigned int num_intervals = r1.size();
+   slab.relaxer.fRelax(w0, rhs0, r1, num_intervals - 1, num_intervals);
+   BoundaryExchange exchange;
+   startExchange(w0, exchange, stats);
+   slab.relaxer.fRelax(w0, rhs0, r1, 0, num_intervals - 1);
+   weightType phi_of_w;
+   if (finishExchange(slab.slabs, exchange, phi_of_w, stats))
+   {
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         r1.layer(0, l) = rhs0.layer(0, l) - (w0.layer(0, l) - phi_of_w[l]);
+      }
+   }
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::gather(const TimeSlabs& slabs, const WeightGrid& local, WeightGrid& global) const
+{
+   // the C-points of the slabs follow each other on the coarse level, so each slab is placed at its first C-point
+   int step_size = local.getLayout()->getStepSize();
+   vector<int> counts(num_ranks);
+   vector<int> displacements(num_ranks);
+   for (unsigned int r = 0; r < num_ranks; r++)
+   {
+      counts[r] = slabs.coarseSize(r) * step_size;
+      displacements[r] = slabs.coarseBegin(r) * step_size;
+   }
+   MPI_Gatherv(local.step(0).data(), counts[rank], MPI_DOUBLE, rank == 0 ? global.step(0).data() : nullptr, counts.data(), displacements.data(), MPI_DOUBLE, 0, comm);
+}
+
+template <typename Propagator>
+unsigned int BasicDistributedMGRITSolver<Propagator>::getCoarseningFactor() const
+{
+   return m;
+}
+
+template <typename Propagator>
+bool BasicDistributedMGRITSolver<Propagator>::getDisplayStats() const
+{
+   return display_stats;
+}
+
+template <typename Propagator>
+unsigned int BasicDistributedMGRITSolver<Propagator>::getMaxLevel() const
+{
+   return max_level;
+}
+
+template <typename Propagator>
+unsigned int BasicDistributedMGRITSolver<Propagator>::getNumRanks() const
+{
+   return num_ranks;
+}
+
+template <typename Propagator>
+unsigned int BasicDistributedMGRITSolver<Propagator>::getNumThreads() const
+{
+   return num_threads;
+}
+
+template <typename Propagator>
+bool BasicDistributedMGRITSolver<Propagator>::getOverlap() const
+{
+   return overlap;
+}
+
+template <typename Propagator>
+bool BasicDistributedMGRITSolver<Propagator>::getPipelineCoarseSolve() const
+{
+   return solver.getPipelineCoarseSolve();
+}
+
+template <typename Propagator>
+unsigned int BasicDistributedMGRITSolver<Propagator>::getRank() const
+{
+   return rank;
+}
+
+template <typename Propagator>
+TimeSlabs BasicDistributedMGRITSolver<Propagator>::getSlabs(unsigned int num_points) const
+{
+   return TimeSlabs(num_points, m, num_ranks);
+}
+
+template <typename Propagator>
+SolverStats BasicDistributedMGRITSolver<Propagator>::getStats() const
+{
+   return *atomic_load(&last_stats);
+}
+
+template <typename Propagator>
+double BasicDistributedMGRITSolver<Propagator>::globalNorm(const WeightGrid& local) const
+{
+   // the squared norms are summed up in the order of the time steps on each process and then over the processes
+   double squared_norm = 0;
+   for (unsigned int i = 0; i < local.size(); i++)
+   {
+      squared_norm += local.step(i).squaredNorm();
+   }
+   double global_squared_norm = 0;
+   MPI_Allreduce(&squared_norm, &global_squared_norm, 1, MPI_DOUBLE, MPI_SUM, comm);
+   return sqrt(global_squared_norm);
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::iteration(const SlabContext<Propagator>& slab, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, const bool& f_cycle, SolverStats& stats) const
+{
+
+   LevelStats& level_stats = stats.levels[0];
+   level_stats.cycles++;
+
+   // apply the initial relaxation to the weights, where the first C-point of each slab is updated with the last F-point
+   // of the slab on its left
+   statsClock::time_point start = statsClock::now();
+   slab.relaxer.fRelax(w0, rhs0);
+   cfRelax(slab, w0, rhs0, r1, stats);
+   level_stats.fcf_relax_time += secondsSince(start);
+
+   // correct the weights on the coarse levels and apply f relaxation to the weights, which again gives the residual
+   // an F-cycle visits the coarse levels a second time with a V-cycle, as in MGRITSolver
+   coarseCorrection(slab, w0, r1, f_cycle, stats);
+   start = statsClock::now();
+   fRelax(slab, w0, rhs0, r1, stats);
+   level_stats.f_relax_time += secondsSince(start);
+   if (f_cycle)
+   {
+      coarseCorrection(slab, w0, r1, false, stats);
+      start = statsClock::now();
+      fRelax(slab, w0, rhs0, r1, stats);
+      level_stats.f_relax_time += secondsSince(start);
+   }
+}
+
+template <typename Propagator>
+listOfWeights BasicDistributedMGRITSolver<Propagator>::run(listOfWeights w0, const listOfWeights& rhs0, const double& tol, const bool& f_cycle) const
+{
+   // solve the slab of this process and collect the slabs of all processes on each of them
+   TimeSlabs slabs = getSlabs(w0.size());
+   unsigned int begin = slabs.begin(rank);
+   WeightGrid w0_slab(listOfWeights(w0.begin() + begin, w0.begin() + slabs.end(rank)));
+   run(w0_slab, WeightGrid(listOfWeights(rhs0.begin() + begin, rhs0.begin() + slabs.end(rank))), w0.size(), tol, f_cycle);
+
+   int step_size = w0_slab.getLayout()->getStepSize();
+   vector<int> counts(num_ranks);
+   vector<int> displacements(num_ranks);
+   for (unsigned int r = 0; r < num_ranks; r++)
+   {
+      counts[r] = slabs.size(r) * step_size;
+      displacements[r] = slabs.begin(r) * step_size;
+   }
+   WeightGrid w0_grid(w0.size(), w0_slab.getLayout());
+   MPI_Allgatherv(w0_slab.step(0).data(), counts[rank], MPI_DOUBLE, w0_grid.step(0).data(), counts.data(), displacements.data(), MPI_DOUBLE, comm);
+   return w0_grid.toList();
+}
+
+template <typename Propagator>
+SolverStats BasicDistributedMGRITSolver<Propagator>::run(WeightGrid& w0, const WeightGrid& rhs0, unsigned int num_points, const double& tol, const bool& f_cycle) const
+{
+
+   statsClock::time_point run_start = statsClock::now();
+   unsigned int iter_num = 0;  // initialize a counter to count the number of iterations MGRIT needs to converge
+
+   // every slab must hold at least one F-interval, so that each process has a left and right neighbour to pass on to
+   TimeSlabs slabs = getSlabs(num_points);
+   if (slabs.numIntervals() < num_ranks)
+   {
+      throw invalid_argument("The " + to_string(num_points) + " time points form fewer F-intervals than the " + to_string(num_ranks) + " processes");
+   }
+   SlabContext<Propagator> slab{slabs, MoveGrids(m), BasicRelax<SlabPropagator<CountingPropagator<Propagator>>>(m, SlabPropagator<CountingPropagator<Propagator>>(phi, slabs.begin(rank)), pool)};
+
+   // a max_level of 1 runs like 2 levels, whose coarse solve on process 0 still collects the stats of level 1
+   SolverStats stats;
+   stats.levels.resize(max(max_level, 2u));
+   unsigned long initial_phi_count = phi.getCount();
+
+   // calculate the initial euclidean norm of the residual, where the first C-point of each slab again needs the last
+   // time step of the slab on its left
+   statsClock::time_point start = statsClock::now();
+   WeightGrid r0(w0.size(), w0.getLayout());
+   BasicMGRITHelper<SlabPropagator<CountingPropagator<Propagator>>>(SlabPropagator<CountingPropagator<Propagator>>(phi, slabs.begin(rank)), pool).residual(w0, rhs0, r0);
+   BoundaryExchange exchange;
+   startExchange(w0, exchange, stats);
+   weightType phi_of_w;
+   if (finishExchange(slabs, exchange, phi_of_w, stats))
+   {
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         r0.layer(0, l) = rhs0.layer(0, l) - (w0.layer(0, l) - phi_of_w[l]);
+      }
+   }
+   double r0_norm = globalNorm(r0);
+   double residual_norm = r0_norm;
+   stats.levels[0].residual_time += secondsSince(start);
+   stats.residual_norms.push_back(r0_norm);
+   WeightGrid r1(slabs.coarseSize(rank), w0.getLayout());  // residual at the C-points of the slab
+   stats.levels[0].bytes_allocated += r0.allocatedBytes() + r1.allocatedBytes();
+
+   // iterate until the euclidean norm of the residual is less than the desired tolerance, which every process sees
+   // the same way, since the norm is summed up over all of them
+   while (residual_norm >= tol)
+   {
+      iter_num++;
+      iteration(slab, w0, rhs0, r1, f_cycle, stats);
+
+      start = statsClock::now();
+      residual_norm = globalNorm(r1);
+      stats.levels[0].residual_time += secondsSince(start);
+      stats.residual_norms.push_back(residual_norm);
+
+      // display stats about MGRIT as it is running if the flag is set
+      if (display_stats and rank == 0)
+      {
+         cout << "Iteration Number: " << iter_num << endl;
+         cout << "Euclidean Norm of the Residual: " << residual_norm << endl;
+      }
+   }
+
+   // collect the stats of the run
+   stats.iterations = iter_num;
+   stats.convergence_rate = iter_num > 0 ? pow(residual_norm / r0_norm, 1.0 / iter_num) : 0.0;
+   stats.levels[0].phi_evaluations = phi.getCount() - initial_phi_count;
+   stats.total_time = secondsSince(run_start);
+   atomic_store(&last_stats, make_shared<const SolverStats>(stats));
+
+   // display the average convergence rate
+   if (display_stats and rank == 0)
+   {
+      cout << "Average Convergence Rate: " << stats.convergence_rate << endl;
+   }
+
+   return stats;
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::scatter(const TimeSlabs& slabs, const WeightGrid& global, WeightGrid& local) const
+{
+   // sends each slab its C-points from process 0, the reverse of gather
+   int step_size = local.getLayout()->getStepSize();
+   vector<int> counts(num_ranks);
+   vector<int> displacements(num_ranks);
+   for (unsigned int r = 0; r < num_ranks; r++)
+   {
+      counts[r] = slabs.coarseSize(r) * step_size;
+      displacements[r] = slabs.coarseBegin(r) * step_size;
+   }
+   MPI_Scatterv(rank == 0 ? global.step(0).data() : nullptr, counts.data(), displacements.data(), MPI_DOUBLE, local.step(0).data(), counts[rank], MPI_DOUBLE, 0, comm);
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::setDisplayStats(bool my_display_stats)
+{
+   display_stats = my_display_stats;
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::setOverlap(bool my_overlap)
+{
+   overlap = my_overlap;
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::setPipelineCoarseSolve(bool my_pipeline_coarse_solve)
+{
+   solver.setPipelineCoarseSolve(my_pipeline_coarse_solve);
+}
+
+template <typename Propagator>
+void BasicDistributedMGRITSolver<Propagator>::startExchange(const WeightGrid& w0, BoundaryExchange& exchange, SolverStats& stats) const
+{
+   // posts the send of the last time step of the slab to the next process and the receive of the last time step of
+   // the slab on the left, without overlap the messages are waited for right away
+   int step_size = w0.getLayout()->getStepSize();
+   exchange.requests[0] = MPI_REQUEST_NULL;
+   exchange.requests[1] = MPI_REQUEST_NULL;
+   if (rank + 1 < num_ranks)
+   {
+      exchange.right = WeightGrid(1, w0.getLayout());
+      exchange.right.step(0) = w0.step(w0.size()-1);
+      MPI_Isend(exchange.right.step(0).data(), step_size, MPI_DOUBLE, rank+1, distributed_mgrit_tag, comm, &exchange.requests[0]);
+   }
+   if (rank > 0)
+   {
+      exchange.left = WeightGrid(1, w0.getLayout());
+      MPI_Irecv(exchange.left.step(0).data(), step_size, MPI_DOUBLE, rank-1, distributed_mgrit_tag, comm, &exchange.requests[1]);
+   }
+   if (!overlap)
+   {
+      statsClock::time_point start = statsClock::now();
+      MPI_Waitall(2, exchange.requests, MPI_STATUSES_IGNORE);
+      stats.levels[0].wait_time += secondsSince(start);
+   }
+}
+
+// the distributed solver with the type-erased phis is compiled once into the MPI library
+extern template class BasicDistributedMGRITSolver<vector<phiFuncType>>;
+
+#endif
\ No newline at end of file
@@ -2,47 +2,323 @@
 #define HH_MGRIT_HELPER_HH
 
 #include <Eigen/Dense>
+#include <functional>
+#include <memory>
+#include <numeric>
 #include <vector>
 
+#include "propagator.h"
+#include "thread_pool.h"
 #include "typedefs.h"
+#include "weight_grid.h"
 
 using namespace Eigen;
 using namespace std;
 
-class MGRITHelper {
+template <typename Propagator>
+class BasicMGRITHelper {
 
    private:
 
-      vector<phiFuncType> phi;        // phi functions used in the forward solve and the matrix multiplication
+      Propagator phi;                 // propagator used in the forward solve and the matrix multiplication
+      shared_ptr<ThreadPool> pool;    // worker pool the independent phi applications are dispatched to
+
+      void applyPhi(unsigned int i, const weightType& weights, weightType& result) const;
+      void applyPhi(unsigned int i, const StepView& weights, weightType& result) const;
 
    public:
 
-      MGRITHelper(vector<phiFuncType> my_phi);
+      BasicMGRITHelper(Propagator my_phi, unsigned int my_num_threads = 1);
+      BasicMGRITHelper(Propagator my_phi, shared_ptr<ThreadPool> my_pool);
 
       // getters and setters
-      vector<phiFuncType> getPhi() const;
-      void setPhi(vector<phiFuncType> my_phi);
+      unsigned int getNumThreads() const;
+      Propagator getPhi() const;
+      void setNumThreads(unsigned int my_num_threads);
+      void setPhi(Propagator my_phi);
 
       // template function must be implemented in the header
       template <typename T> 
       listOfWeights addOrSubtract(const listOfWeights& first_list, const listOfWeights& second_list, const T& add_or_subtract) const
       {
+        // the time steps are independent, so each thread combines one chunk of them
         listOfWeights result(first_list.size());
-        transform(first_list.begin(), first_list.end(), second_list.begin(), result.begin(), 
-                  [add_or_subtract](weightType w1, weightType w2) 
-                  {
-                    transform(w1.begin(), w1.end(), w2.begin(), w1.begin(), add_or_subtract);
-                    return w1;
-                  });
+        pool->parallelForChunks(0, first_list.size(), [&first_list, &second_list, &add_or_subtract, &result](unsigned int begin, unsigned int end)
+        {
+          transform(first_list.begin() + begin, first_list.begin() + end, second_list.begin() + begin, result.begin() + begin, 
+                    [add_or_subtract](weightType w1, const weightType& w2) 
+                    {
+                      transform(w1.begin(), w1.end(), w2.begin(), w1.begin(), add_or_subtract);
+                      return w1;
+                    });
+        });
 
         return result;
       }
 
+      // the WeightGrid overload applies add_or_subtract to each coefficient and may write its result into either input
+      template <typename T> 
+      void addOrSubtract(const WeightGrid& first_grid, const WeightGrid& second_grid, const T& add_or_subtract, WeightGrid& result) const
+      {
+        pool->parallelForChunks(0, first_grid.size(), [&first_grid, &second_grid, &add_or_subtract, &result](unsigned int begin, unsigned int end)
+        {
+          for (unsigned int i = begin; i < end; i++)
+          {
+            result.step(i) = first_grid.step(i).binaryExpr(second_grid.step(i), add_or_subtract);
+          }
+        });
+      }
+
       double euclideanNorm(const listOfWeights& weights) const;
+      double euclideanNorm(const WeightGrid& weights) const;
       listOfWeights forwardSolve(const listOfWeights& rhs) const;
+      void forwardSolve(const WeightGrid& rhs, WeightGrid& result) const;
+      void forwardSolve(const WeightGrid& rhs, WeightGrid& result, const function<void (unsigned int)>& step_solved) const;
       listOfWeights matMultiply(const listOfWeights& weights) const;
+      void matMultiply(const WeightGrid& weights, WeightGrid& result) const;
       listOfWeights residual(const listOfWeights& weights, const listOfWeights& rhs) const;
+      void residual(const WeightGrid& weights, const WeightGrid& rhs, WeightGrid& result) const;
+      double residualNorm(const listOfWeights& weights, const listOfWeights& rhs) const;
+      double residualNorm(const WeightGrid& weights, const WeightGrid& rhs) const;
 
 };
 
+// the helper with a list of phi functions, which can be built at run time
+typedef BasicMGRITHelper<vector<phiFuncType>> MGRITHelper;
+
+// the class template is implemented in the header, so that it can be instantiated on any propagator
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::applyPhi(unsigned int i, const weightType& weights, weightType& result) const
+{
+   PropagatorTraits<Propagator>::apply(phi, i, weights, result);
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::applyPhi(unsigned int i, const StepView& weights, weightType& result) const
+{
+   PropagatorTraits<Propagator>::apply(phi, i, weights, result);
+}
+
+template <typename Propagator>
+double BasicMGRITHelper<Propagator>::euclideanNorm(const listOfWeights& weights) const
+{
+   double norm = 0;
+   for (int i = 0; i < weights.size(); i++)
+   {
+      for (const MatrixXd& weight : weights[i])
+      {
+         norm += weight.squaredNorm();
+      }
+   }
+   norm = sqrt(norm);
+   return norm;
+}
+
+template <typename Propagator>
+double BasicMGRITHelper<Propagator>::euclideanNorm(const WeightGrid& weights) const
+{
+   double norm = 0;
+   for (unsigned int i = 0; i < weights.size(); i++)
+   {
+      norm += weights.step(i).squaredNorm();
+   }
+   norm = sqrt(norm);
+   return norm;
+}
+
+template <typename Propagator>
+listOfWeights BasicMGRITHelper<Propagator>::forwardSolve(const listOfWeights& rhs) const
+{
+   listOfWeights result(rhs.size());
+   weightType phi_of_w;
+   result[0] = rhs[0];
+   for (int i = 1; i < rhs.size(); i++)
+   {
+    applyPhi(i-1, result[i-1], phi_of_w);
+    transform(rhs[i].begin(), rhs[i].end(), phi_of_w.begin(), back_inserter(result[i]), plus<MatrixXd>());
+   }
+   return result;
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::forwardSolve(const WeightGrid& rhs, WeightGrid& result) const
+{
+   forwardSolve(rhs, result, [](unsigned int) {});
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::forwardSolve(const WeightGrid& rhs, WeightGrid& result, const function<void (unsigned int)>& step_solved) const
+{
+   // result may be the rhs itself, since step i only reads the already solved step i-1
+   // step_solved is called with each step as soon as it is solved, so that a caller can start on the work that only
+   // depends on the steps solved so far while the serial solve goes on
+   weightType phi_of_w;
+   result.step(0) = rhs.step(0);
+   step_solved(0);
+   for (unsigned int i = 1; i < rhs.size(); i++)
+   {
+      applyPhi(i-1, result.stepView(i-1), phi_of_w);
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         result.layer(i, l) = rhs.layer(i, l) + phi_of_w[l];
+      }
+      step_solved(i);
+   }
+}
+
+template <typename Propagator>
+unsigned int BasicMGRITHelper<Propagator>::getNumThreads() const
+{
+   return pool->getNumThreads();
+}
+
+template <typename Propagator>
+Propagator BasicMGRITHelper<Propagator>::getPhi() const
+{
+   return phi;
+}
+
+template <typename Propagator>
+listOfWeights BasicMGRITHelper<Propagator>::matMultiply(const listOfWeights& weights) const
+{
+   // every step only reads the weights, so each thread multiplies one chunk of the steps with its own buffer
+   listOfWeights result(weights.size());
+   result[0] = weights[0];
+   pool->parallelForChunks(1, weights.size(), [this, &weights, &result](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin; i < end; i++)
+      {
+         applyPhi(i-1, weights[i-1], phi_of_w);
+         transform(weights[i].begin(), weights[i].end(), phi_of_w.begin(), back_inserter(result[i]), minus<MatrixXd>());
+      }
+   });
+   return result;
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::matMultiply(const WeightGrid& weights, WeightGrid& result) const
+{
+   // result must be a different grid than the weights, since step i reads the weights of step i-1
+   // every step only reads the weights, so each thread multiplies one chunk of the steps with its own buffer
+   result.step(0) = weights.step(0);
+   pool->parallelForChunks(1, weights.size(), [this, &weights, &result](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin; i < end; i++)
+      {
+         applyPhi(i-1, weights.stepView(i-1), phi_of_w);
+         for (unsigned int l = 0; l < phi_of_w.size(); l++)
+         {
+            result.layer(i, l) = weights.layer(i, l) - phi_of_w[l];
+         }
+      }
+   });
+}
+
+template <typename Propagator>
+BasicMGRITHelper<Propagator>::BasicMGRITHelper(Propagator my_phi, unsigned int my_num_threads) : phi{move(my_phi)}, 
+                                                                                                  pool{make_shared<ThreadPool>(my_num_threads)}{}
+
+template <typename Propagator>
+BasicMGRITHelper<Propagator>::BasicMGRITHelper(Propagator my_phi, shared_ptr<ThreadPool> my_pool) : phi{move(my_phi)}, 
+                                                                                                    pool{my_pool}{}
+
+template <typename Propagator>
+listOfWeights BasicMGRITHelper<Propagator>::residual(const listOfWeights& weights, const listOfWeights& rhs) const
+{
+   return addOrSubtract(rhs, matMultiply(weights), minus<MatrixXd>());
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::residual(const WeightGrid& weights, const WeightGrid& rhs, WeightGrid& result) const
+{
+   // result may be the rhs, but not the weights, since step i reads the weights of step i-1
+   // step i of the result only depends on step i of the rhs, so the steps are computed in chunks as in matMultiply
+   result.step(0) = rhs.step(0) - weights.step(0);
+   pool->parallelForChunks(1, weights.size(), [this, &weights, &rhs, &result](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin; i < end; i++)
+      {
+         applyPhi(i-1, weights.stepView(i-1), phi_of_w);
+         for (unsigned int l = 0; l < phi_of_w.size(); l++)
+         {
+            result.layer(i, l) = rhs.layer(i, l) - (weights.layer(i, l) - phi_of_w[l]);
+         }
+      }
+   });
+}
+
+template <typename Propagator>
+double BasicMGRITHelper<Propagator>::residualNorm(const listOfWeights& weights, const listOfWeights& rhs) const
+{
+   // the squared norm of each time step is kept separately and summed in order, so the norm does not depend on the number of threads
+   // each thread computes the squared norms of one chunk of the steps with its own buffer
+   if (weights.empty()) {return 0;}
+   vector<double> squared_norms(weights.size());
+   squared_norms[0] = 0;
+   for (int l = 0; l < weights[0].size(); l++)
+   {
+      squared_norms[0] += (rhs[0][l] - weights[0][l]).squaredNorm();
+   }
+   pool->parallelForChunks(1, weights.size(), [this, &weights, &rhs, &squared_norms](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin; i < end; i++)
+      {
+         applyPhi(i-1, weights[i-1], phi_of_w);
+         double squared_norm = 0;
+         for (unsigned int l = 0; l < phi_of_w.size(); l++)
+         {
+            squared_norm += (rhs[i][l] - (weights[i][l] - phi_of_w[l])).squaredNorm();
+         }
+         squared_norms[i] = squared_norm;
+      }
+   });
+   return sqrt(accumulate(squared_norms.begin(), squared_norms.end(), 0.0));
+}
+
+template <typename Propagator>
+double BasicMGRITHelper<Propagator>::residualNorm(const WeightGrid& weights, const WeightGrid& rhs) const
+{
+   // computes the norm of rhs - A*weights in one pass without building the residual
+   // each thread computes the squared norms of one chunk of the steps with its own buffer
+   if (weights.size() == 0) {return 0;}
+   vector<double> squared_norms(weights.size());
+   squared_norms[0] = (rhs.step(0) - weights.step(0)).squaredNorm();
+   pool->parallelForChunks(1, weights.size(), [this, &weights, &rhs, &squared_norms](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin; i < end; i++)
+      {
+         applyPhi(i-1, weights.stepView(i-1), phi_of_w);
+         double squared_norm = 0;
+         for (unsigned int l = 0; l < phi_of_w.size(); l++)
+         {
+            squared_norm += (rhs.layer(i, l) - (weights.layer(i, l) - phi_of_w[l])).squaredNorm();
+         }
+         squared_norms[i] = squared_norm;
+      }
+   });
+   return sqrt(accumulate(squared_norms.begin(), squared_norms.end(), 0.0));
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::setNumThreads(unsigned int my_num_threads)
+{
+   pool = make_shared<ThreadPool>(my_num_threads);
+}
+
+template <typename Propagator>
+void BasicMGRITHelper<Propagator>::setPhi(Propagator my_phi)
+{
+   phi = move(my_phi);
+}
+
+// the helpers with the type-erased phis are compiled once into the library
+extern template class BasicMGRITHelper<vector<phiFuncType>>;
+extern template class BasicMGRITHelper<CountingPropagator<vector<phiFuncType>>>;
+
 #endif
\ No newline at end of file
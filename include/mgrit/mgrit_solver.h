@@ -1,54 +1,583 @@
 #ifndef HH_MGRIT_SOLVER_HH
 #define HH_MGRIT_SOLVER_HH
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
 #include <Eigen/Dense>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
 #include "mgrit_helper.h"
 #include "move_grids.h"
+#include "propagator.h"
 #include "relax.h"
+#include "solver_stats.h"
+#include "thread_pool.h"
 #include "typedefs.h"
+#include "weight_grid.h"
 
 using namespace Eigen;
 using namespace std;
 
-class MGRITSolver {
+// the helper classes of one grid level, which the solver builds once so that moving between levels copies nothing
+template <typename Propagator>
+struct LevelContext {
+
+   BasicMGRITHelper<CountingPropagator<Propagator>> helper;   // applies the propagator of the level
+   MoveGrids mover;                                           // moves the weights between the level and the next coarser one
+   BasicRelax<CountingPropagator<Propagator>> relaxer;        // relaxes the weights on the level
+
+};
+
+template <typename Propagator>
+class BasicMGRITSolver {
 
    private:
 
-      unsigned int current_level = 0;           // keeps track of the current grid level MGRIT is on
+      vector<LevelContext<Propagator>> contexts; // helper classes that assist in implementing MGRIT on each grid level
+      vector<CountingPropagator<Propagator>> counted_phis; // propagators that also count how often they are applied
       bool display_stats;                       // displays stats about the MGRIT algorithm as it is running
+      mutable shared_ptr<const SolverStats> last_stats;   // timings and counters of the last run that finished
       unsigned int m;                           // coarsening factor
       unsigned int max_level;                   // denotes the maximum coarse level grid MGRIT will recurse to
-      vector<vector<phiFuncType>> phis;         // list of phi functions on each grid level
-      
-      // helper classes that assist in implementing the MGRIT algorithm
-      MGRITHelper helper;
-      MoveGrids mover;
-      Relax relaxer;  
-
-      listOfWeights fIteration(listOfWeights w0, const listOfWeights& rhs0);  
-      MGRITHelper makeMGRITHelperObject(const vector<phiFuncType>& phi) const;
-      MoveGrids makeMoveGridsObject(const unsigned int& m) const;
-      Relax makeRelaxObject(const unsigned int& m, const vector<phiFuncType>& phi) const;   
-      listOfWeights vIteration(listOfWeights w0, const listOfWeights& rhs0);
+      unsigned int num_threads;                 // number of threads the phi functions are applied on
+      vector<Propagator> phis;                  // propagator on each grid level
+      bool pipeline_coarse_solve;               // overlaps the coarsest forward solve with the F-relaxation above it on several threads
+      shared_ptr<ThreadPool> pool;              // worker pool shared by the helper classes of all levels
+
+      static vector<CountingPropagator<Propagator>> countPhis(const vector<Propagator>& phis);
+      void correct(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, const WeightGrid& w1, WeightGrid& v1, WeightGrid* r1, SolverStats& stats) const;
+      void fIteration(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const;
+      vector<LevelContext<Propagator>> makeLevelContexts() const;
+      void pipelinedCoarseSolve(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, const WeightGrid& w1, const WeightGrid& rhs1, WeightGrid& v1, WeightGrid* r1, SolverStats& stats) const;
+      void vIteration(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const;
 
    public:
 
-      MGRITSolver(unsigned int my_m, vector<vector<phiFuncType>> my_phis, unsigned int my_max_level, bool my_display_stats = false);
+      BasicMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats = false, unsigned int my_num_threads = 1);
+
+      // applies the phi functions on the threads of a pool the caller shares, e.g. with the slab of a distributed solver
+      BasicMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats, shared_ptr<ThreadPool> my_pool);
 
       // getters and setters
       unsigned int getCoarseningFactor() const;
       bool getDisplayStats() const;
       unsigned int getMaxLevel() const;
-      vector<vector<phiFuncType>> getPhis() const;
+      unsigned int getNumThreads() const;
+      vector<Propagator> getPhis() const;
+      bool getPipelineCoarseSolve() const;
+      SolverStats getStats() const;
       void setCoarseningFactor(unsigned int my_m);
       void setDisplayStats(bool my_display_stats);
       void setMaxLevel(unsigned int my_max_level);
-      void setPhis(vector<vector<phiFuncType>> my_phis);
+      void setNumThreads(unsigned int my_num_threads);
+      void setPhis(vector<Propagator> my_phis);
+      void setPipelineCoarseSolve(bool my_pipeline_coarse_solve);
+
+      // approximates the correction e1 of the weights w1 at the C-points of a level by solving the system of the next
+      // coarser level the way a cycle on the level does, where r1 is the residual at the C-points - lets a solver that
+      // distributes the finest level over several processes hand the coarser levels to this one
+      void coarseCorrection(unsigned int level, const WeightGrid& w1, const WeightGrid& r1, const bool& f_cycle, WeightGrid& e1, SolverStats& stats) const;
 
-      listOfWeights run(listOfWeights w0, const listOfWeights& rhs0, const double& tol, const bool& f_cycle);
+      // runs only read the solver, so several threads may run the same solver at once as long as none of them calls a
+      // setter in the meantime - the phi evaluations of a run then also include those of the runs that overlap it
+      listOfWeights run(listOfWeights w0, const listOfWeights& rhs0, const double& tol, const bool& f_cycle) const;
+      SolverStats run(WeightGrid& w0, const WeightGrid& rhs0, const double& tol, const bool& f_cycle) const;
 };
 
+// the solver with a list of phi functions on each level, which can be built at run time
+typedef BasicMGRITSolver<vector<phiFuncType>> MGRITSolver;
+
+// the smallest number of grid levels for which the coarsest grid holds at most max_coarse_size of the num_points time
+// points when coarsening by m, which picks max_level from the size of the serial coarse solve a run can afford
+unsigned int maxLevelForCoarseSize(unsigned int num_points, unsigned int m, unsigned int max_coarse_size);
+
+// the class template is implemented in the header, so that it can be instantiated on any propagator
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::coarseCorrection(unsigned int level, const WeightGrid& w1, const WeightGrid& r1, const bool& f_cycle, WeightGrid& e1, SolverStats& stats) const
+{
+
+   const LevelContext<Propagator>& coarse = contexts[level+1];
+   vector<unsigned long> initial_phi_counts;
+   for (const CountingPropagator<Propagator>& phi : counted_phis)
+   {
+      initial_phi_counts.push_back(phi.getCount());
+   }
+
+   // Construct the rhs of the linear system on the coarse level
+   statsClock::time_point start = statsClock::now();
+   WeightGrid rhs1(w1.size(), w1.getLayout());
+   coarse.helper.matMultiply(w1, rhs1);
+   coarse.helper.addOrSubtract(rhs1, r1, plus<double>(), rhs1);
+   stats.levels[level].residual_time += secondsSince(start);
+
+   // Solve the coarse linear system if on the coarsest level - otherwise run one cycle on the next grid level
+   e1 = w1;
+   WeightGrid r2;       // residual buffer for the next coarser level
+   if (level + 1 >= (max_level-1))
+   {
+      start = statsClock::now();
+      coarse.helper.forwardSolve(rhs1, e1);
+      stats.levels[level+1].coarse_solve_time += secondsSince(start);
+   }
+   else
+   {
+      r2 = WeightGrid((e1.size() + m - 1) / m, e1.getLayout());
+      f_cycle ? fIteration(level+1, e1, rhs1, r2, stats) : vIteration(level+1, e1, rhs1, r2, stats);
+   }
+   stats.levels[level].bytes_allocated += e1.allocatedBytes() + rhs1.allocatedBytes() + r2.allocatedBytes();
+
+   // calculate the coarse level error approximation
+   start = statsClock::now();
+   coarse.helper.addOrSubtract(e1, w1, minus<double>(), e1);
+   stats.levels[level].project_time += secondsSince(start);
+
+   // only the coarser levels are counted, since the caller applies the phi of the level itself
+   for (unsigned int l = level + 1; l < stats.levels.size() and l < counted_phis.size(); l++)
+   {
+      stats.levels[l].phi_evaluations += counted_phis[l].getCount() - initial_phi_counts[l];
+   }
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::correct(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, const WeightGrid& w1, WeightGrid& v1, WeightGrid* r1, SolverStats& stats) const
+{
+   LevelStats& level_stats = stats.levels[level];
+   const LevelContext<Propagator>& fine = contexts[level];
+   const LevelContext<Propagator>& coarse = contexts[level+1];
+
+   // calculate the coarse level error approximation
+   statsClock::time_point start = statsClock::now();
+   WeightGrid& e1 = v1;
+   coarse.helper.addOrSubtract(v1, w1, minus<double>(), e1);
+
+   // project the weights from the coarse level to the fine level
+   fine.mover.project(w0, e1);
+   level_stats.project_time += secondsSince(start);
+
+   // apply f relaxation to the weights, which also gives the coarse residual if r1 is not null
+   start = statsClock::now();
+   r1 ? fine.relaxer.fRelax(w0, rhs0, *r1) : fine.relaxer.fRelax(w0, rhs0);
+   level_stats.f_relax_time += secondsSince(start);
+}
+
+template <typename Propagator>
+vector<CountingPropagator<Propagator>> BasicMGRITSolver<Propagator>::countPhis(const vector<Propagator>& phis)
+{
+   // wrap the propagator of each level so that every application is counted for the stats, the counters are shared
+   // between threads and copies, and the count of a run is the difference to the count at its start
+   vector<CountingPropagator<Propagator>> counted_phis;
+   for (const Propagator& level_phi : phis)
+   {
+      counted_phis.push_back(CountingPropagator<Propagator>(level_phi));
+   }
+   return counted_phis;
+}
+
+template <typename Propagator>
+unsigned int BasicMGRITSolver<Propagator>::getCoarseningFactor() const
+{
+   return m;
+}
+
+template <typename Propagator>
+bool BasicMGRITSolver<Propagator>::getDisplayStats() const
+{
+   return display_stats;
+}
+
+template <typename Propagator>
+unsigned int BasicMGRITSolver<Propagator>::getMaxLevel() const
+{
+   return max_level;
+}
+
+template <typename Propagator>
+unsigned int BasicMGRITSolver<Propagator>::getNumThreads() const
+{
+   return num_threads;
+}
+
+template <typename Propagator>
+vector<Propagator> BasicMGRITSolver<Propagator>::getPhis() const
+{
+   return phis;
+}
+
+template <typename Propagator>
+bool BasicMGRITSolver<Propagator>::getPipelineCoarseSolve() const
+{
+   return pipeline_coarse_solve;
+}
+
+template <typename Propagator>
+SolverStats BasicMGRITSolver<Propagator>::getStats() const
+{
+   return *atomic_load(&last_stats);
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::fIteration(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const
+{
+
+   LevelStats& level_stats = stats.levels[level];
+   const LevelContext<Propagator>& fine = contexts[level];
+   const LevelContext<Propagator>& coarse = contexts[level+1];
+   level_stats.cycles++;
+
+   // apply the initial relaxation to the weights
+   // the residual vanishes at the F-points afterwards, so the relaxation also gives the coarse residual r1 at the C-points
+   statsClock::time_point start = statsClock::now();
+   fine.relaxer.fcfRelax(w0, rhs0, r1);
+   level_stats.fcf_relax_time += secondsSince(start);
+
+   // restrict the weights to the coarse level
+   start = statsClock::now();
+   WeightGrid w1 = fine.mover.restrict(w0);  // get a view onto the coarse weights
+   WeightGrid v1 = w1;  // the coarse solve updates its own copy, since w1 is a view onto the fine C-points
+   level_stats.restrict_time += secondsSince(start);
+   
+   // Construct the rhs of the linear system on the coarse level
+   start = statsClock::now();
+   WeightGrid rhs1(w1.size(), w1.getLayout());
+   coarse.helper.matMultiply(w1, rhs1);
+   coarse.helper.addOrSubtract(rhs1, r1, plus<double>(), rhs1);
+   level_stats.residual_time += secondsSince(start);
+
+   // Solve the coarse linear system if on the coarsest level - otherwise recurse down to the next grid level
+   // then correct the weights and apply f relaxation to them, which again gives the coarse residual
+   WeightGrid r2;       // residual buffer for the next coarser level
+   level_stats.bytes_allocated += v1.allocatedBytes() + rhs1.allocatedBytes();
+   if (level + 1 >= (max_level-1) and num_threads > 1 and pipeline_coarse_solve)
+   {
+      pipelinedCoarseSolve(level, w0, rhs0, w1, rhs1, v1, &r1, stats);
+   }
+   else if (level + 1 >= (max_level-1))
+   {
+      start = statsClock::now();
+      coarse.helper.forwardSolve(rhs1, v1);
+      stats.levels[level+1].coarse_solve_time += secondsSince(start);
+      correct(level, w0, rhs0, w1, v1, &r1, stats);
+   }
+   else
+   {
+      r2 = WeightGrid((v1.size() + m - 1) / m, v1.getLayout());
+      level_stats.bytes_allocated += r2.allocatedBytes();
+      fIteration(level+1, v1, rhs1, r2, stats);
+      correct(level, w0, rhs0, w1, v1, &r1, stats);
+   }
+
+   // restrict the weights to the coarse level
+   start = statsClock::now();
+   w1 = fine.mover.restrict(w0);  // get a view onto the coarse weights
+   v1 = w1;
+   level_stats.restrict_time += secondsSince(start);
+
+   // Construct the rhs of the linear system on the coarse level
+   start = statsClock::now();
+   coarse.helper.matMultiply(w1, rhs1);
+   coarse.helper.addOrSubtract(rhs1, r1, plus<double>(), rhs1);
+   level_stats.residual_time += secondsSince(start);
+
+   // Solve the coarse linear system if on the coarsest level - otherwise recurse down to the next grid level
+   // then correct the weights and apply f relaxation to them
+   // on the finest level this also leaves the residual at the C-points in r1 for the convergence check in run
+   WeightGrid* c_residuals = level == 0 ? &r1 : nullptr;
+   if (level + 1 >= (max_level-1) and num_threads > 1 and pipeline_coarse_solve)
+   {
+      pipelinedCoarseSolve(level, w0, rhs0, w1, rhs1, v1, c_residuals, stats);
+   }
+   else if (level + 1 >= (max_level-1))
+   {
+      start = statsClock::now();
+      coarse.helper.forwardSolve(rhs1, v1);
+      stats.levels[level+1].coarse_solve_time += secondsSince(start);
+      correct(level, w0, rhs0, w1, v1, c_residuals, stats);
+   }
+   else
+   {
+      vIteration(level+1, v1, rhs1, r2, stats);
+      correct(level, w0, rhs0, w1, v1, c_residuals, stats);
+   }
+}
+
+template <typename Propagator>
+vector<LevelContext<Propagator>> BasicMGRITSolver<Propagator>::makeLevelContexts() const
+{
+   // the levels share the thread pool of the solver, so the number of threads does not grow with the number of levels
+   vector<LevelContext<Propagator>> level_contexts;
+   for (const CountingPropagator<Propagator>& phi : counted_phis)
+   {
+      level_contexts.push_back(LevelContext<Propagator>{BasicMGRITHelper<CountingPropagator<Propagator>>(phi, pool), 
+                                                        MoveGrids(m), 
+                                                        BasicRelax<CountingPropagator<Propagator>>(m, phi, pool)});
+   }
+   return level_contexts;
+}
+
+template <typename Propagator>
+BasicMGRITSolver<Propagator>::BasicMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats, unsigned int my_num_threads) : counted_phis{countPhis(my_phis)}, 
+                                                                                                                                                                               display_stats{my_display_stats}, 
+                                                                                                                                                                               last_stats{make_shared<const SolverStats>()}, 
+                                                                                                                                                                               m{my_m}, 
+                                                                                                                                                                               max_level{my_max_level}, 
+                                                                                                                                                                               num_threads{my_num_threads}, 
+                                                                                                                                                                               phis{my_phis}, 
+                                                                                                                                                                               pipeline_coarse_solve{true}, 
+                                                                                                                                                                               pool{make_shared<ThreadPool>(my_num_threads)}
+{
+   contexts = makeLevelContexts();
+}
+
+template <typename Propagator>
+BasicMGRITSolver<Propagator>::BasicMGRITSolver(unsigned int my_m, vector<Propagator> my_phis, unsigned int my_max_level, bool my_display_stats, shared_ptr<ThreadPool> my_pool) : counted_phis{countPhis(my_phis)}, 
+                                                                                                                                                                                  display_stats{my_display_stats}, 
+                                                                                                                                                                                  last_stats{make_shared<const SolverStats>()}, 
+                                                                                                                                                                                  m{my_m}, 
+                                                                                                                                                                                  max_level{my_max_level}, 
+                                                                                                                                                                                  num_threads{my_pool->getNumThreads()}, 
+                                                                                                                                                                                  phis{my_phis}, 
+                                                                                                                                                                                  pipeline_coarse_solve{true}, 
+                                                                                                                                                                                  pool{my_pool}
+{
+   contexts = makeLevelContexts();
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::pipelinedCoarseSolve(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, const WeightGrid& w1, const WeightGrid& rhs1, WeightGrid& v1, WeightGrid* r1, SolverStats& stats) const
+{
+
+   // the forward solve on the coarsest level is serial, but F-interval i of the level only reads C-point i (and C-point
+   // i+1 for the residual), so the first task of the loop solves the coarse level and corrects each C-point right after
+   // it is solved, while the other tasks relax the F-intervals as soon as the C-points they read are corrected
+   const LevelContext<Propagator>& fine = contexts[level];
+   const LevelContext<Propagator>& coarse = contexts[level+1];
+   unsigned int num_c_points = v1.size();
+   unsigned int lookahead = r1 ? 2 : 1;   // number of C-points from the start of an interval it reads
+   unsigned int num_corrected = 0;        // C-points corrected so far
+   bool failed = false;                   // the forward solve threw, so the intervals must not wait for it
+   mutex progress_mutex;
+   condition_variable progress;
+   double solve_time = 0;
+
+   // the pool claims the tasks in order, so the forward solve always runs and no interval waits for a task behind it
+   statsClock::time_point start = statsClock::now();
+   pool->parallelFor(0, num_c_points + 1, [&](unsigned int task)
+   {
+      if (task == 0)
+      {
+         statsClock::time_point solve_start = statsClock::now();
+         try
+         {
+            coarse.helper.forwardSolve(rhs1, v1, [&](unsigned int i)
+            {
+               // the same operations as computing the error and projecting it, so the weights do not change
+               w0.step(i*m) += v1.step(i) - w1.step(i);
+               lock_guard<mutex> lock(progress_mutex);
+               num_corrected = i + 1;
+               progress.notify_all();
+            });
+         }
+         catch (...)
+         {
+            lock_guard<mutex> lock(progress_mutex);
+            failed = true;
+            progress.notify_all();
+            throw;
+         }
+         solve_time = secondsSince(solve_start);
+         return;
+      }
+
+      unsigned int interval = task - 1;
+      {
+         unique_lock<mutex> lock(progress_mutex);
+         progress.wait(lock, [&]() { return failed or num_corrected >= min(interval + lookahead, num_c_points); });
+         if (failed) {return;}
+      }
+      r1 ? fine.relaxer.fRelax(w0, rhs0, *r1, interval, interval + 1) : fine.relaxer.fRelax(w0, rhs0, interval, interval + 1);
+   });
+
+   // the forward solve counts as the coarse solve and the relaxation only with the time it went on after the solve
+   stats.levels[level+1].coarse_solve_time += solve_time;
+   stats.levels[level].f_relax_time += secondsSince(start) - solve_time;
+}
+
+template <typename Propagator>
+listOfWeights BasicMGRITSolver<Propagator>::run(listOfWeights w0, const listOfWeights& rhs0, const double& tol, const bool& f_cycle) const
+{
+   WeightGrid w0_grid(w0);
+   run(w0_grid, WeightGrid(rhs0), tol, f_cycle);
+   return w0_grid.toList();
+}
+
+template <typename Propagator>
+SolverStats BasicMGRITSolver<Propagator>::run(WeightGrid& w0, const WeightGrid& rhs0, const double& tol, const bool& f_cycle) const
+{
+
+   statsClock::time_point run_start = statsClock::now();
+   unsigned int iter_num = 0;  // initialize a counter to count the number of iterations MGRIT needs to converge
+
+   // each run collects its own stats and remembers how often the phis had been applied before it
+   // a max_level of 1 runs like 2 levels, whose coarse solve still collects the stats of level 1
+   SolverStats stats;
+   stats.levels.resize(max(max_level, 2u));
+   vector<unsigned long> initial_phi_counts;
+   for (const CountingPropagator<Propagator>& phi : counted_phis)
+   {
+      initial_phi_counts.push_back(phi.getCount());
+   }
+
+   // calculate the initial euclidean norm of the residual
+   statsClock::time_point start = statsClock::now();
+   double r0_norm = contexts[0].helper.residualNorm(w0, rhs0); 
+   double residual_norm = r0_norm;
+   stats.levels[0].residual_time += secondsSince(start);
+   stats.residual_norms.push_back(r0_norm);
+   WeightGrid r1((w0.size() + m - 1) / m, w0.getLayout());  // residual at the C-points of the fine level
+   stats.levels[0].bytes_allocated += r1.allocatedBytes();
+
+   // iterate until the euclidean norm of the residual is less than the desired tolerance
+   while (residual_norm >= tol)
+   {
+      iter_num++;
+      f_cycle? fIteration(0, w0, rhs0, r1, stats) : vIteration(0, w0, rhs0, r1, stats); // run v or f cycles depending on the user input
+
+      // each cycle ends with an F-relaxation, after which the fine residual is only nonzero at the C-points
+      // so the residual it left in r1 gives the norm without applying phi on the whole fine level again
+      start = statsClock::now();
+      residual_norm = contexts[0].helper.euclideanNorm(r1);
+      stats.levels[0].residual_time += secondsSince(start);
+      stats.residual_norms.push_back(residual_norm);
+
+      // display stats about MGRIT as it is running if the flag is set
+      if (display_stats)
+      {
+         cout << "Iteration Number: " << iter_num << endl;
+         cout << "Euclidean Norm of the Residual: " << residual_norm << endl;
+      }
+   }
+
+   // collect the stats of the run
+   stats.iterations = iter_num;
+   stats.convergence_rate = iter_num > 0 ? pow(residual_norm / r0_norm, 1.0 / iter_num) : 0.0;
+   for (unsigned int l = 0; l < stats.levels.size() and l < counted_phis.size(); l++)
+   {
+      stats.levels[l].phi_evaluations = counted_phis[l].getCount() - initial_phi_counts[l];
+   }
+   stats.total_time = secondsSince(run_start);
+   atomic_store(&last_stats, make_shared<const SolverStats>(stats));
+
+   // display the average convergence rate
+   if (display_stats)
+   {
+      cout << "Average Convergence Rate: " << stats.convergence_rate << endl;
+   }
+
+   return stats;
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setCoarseningFactor(unsigned int my_m)
+{
+   m = my_m;
+   contexts = makeLevelContexts();
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setDisplayStats(bool my_display_stats)
+{
+   display_stats = my_display_stats;
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setMaxLevel(unsigned int my_max_level)
+{
+   max_level = my_max_level;
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setNumThreads(unsigned int my_num_threads)
+{
+   num_threads = my_num_threads;
+   pool = make_shared<ThreadPool>(my_num_threads);
+   contexts = makeLevelContexts();
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setPhis(vector<Propagator> my_phis)
+{
+   phis = my_phis;
+   counted_phis = countPhis(phis);
+   contexts = makeLevelContexts();
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::setPipelineCoarseSolve(bool my_pipeline_coarse_solve)
+{
+   pipeline_coarse_solve = my_pipeline_coarse_solve;
+}
+
+template <typename Propagator>
+void BasicMGRITSolver<Propagator>::vIteration(unsigned int level, WeightGrid& w0, const WeightGrid& rhs0, WeightGrid& r1, SolverStats& stats) const
+{
+
+   LevelStats& level_stats = stats.levels[level];
+   const LevelContext<Propagator>& fine = contexts[level];
+   const LevelContext<Propagator>& coarse = contexts[level+1];
+   level_stats.cycles++;
+
+   // apply the initial relaxation to the weights
+   // the residual vanishes at the F-points afterwards, so the relaxation also gives the coarse residual r1 at the C-points
+   statsClock::time_point start = statsClock::now();
+   fine.relaxer.fcfRelax(w0, rhs0, r1);
+   level_stats.fcf_relax_time += secondsSince(start);
+
+   // restrict the weights to the coarse level
+   start = statsClock::now();
+   WeightGrid w1 = fine.mover.restrict(w0);  // get a view onto the coarse weights
+   WeightGrid v1 = w1;  // the coarse solve updates its own copy, since w1 is a view onto the fine C-points
+   level_stats.restrict_time += secondsSince(start);
+   
+   // Construct the rhs of the linear system on the coarse level
+   start = statsClock::now();
+   WeightGrid rhs1(w1.size(), w1.getLayout());
+   coarse.helper.matMultiply(w1, rhs1);
+   coarse.helper.addOrSubtract(rhs1, r1, plus<double>(), rhs1);
+   level_stats.residual_time += secondsSince(start);
+
+   // Solve the coarse linear system if on the coarsest level - otherwise recurse down to the next grid level
+   // then correct the weights and apply f relaxation to them on the fine level
+   // on the finest level this also leaves the residual at the C-points in r1 for the convergence check in run
+   WeightGrid* c_residuals = level == 0 ? &r1 : nullptr;
+   level_stats.bytes_allocated += v1.allocatedBytes() + rhs1.allocatedBytes();
+   if (level + 1 >= (max_level-1) and num_threads > 1 and pipeline_coarse_solve)
+   {
+      pipelinedCoarseSolve(level, w0, rhs0, w1, rhs1, v1, c_residuals, stats);
+   }
+   else if (level + 1 >= (max_level-1))
+   {
+      start = statsClock::now();
+      coarse.helper.forwardSolve(rhs1, v1);
+      stats.levels[level+1].coarse_solve_time += secondsSince(start);
+      correct(level, w0, rhs0, w1, v1, c_residuals, stats);
+   }
+   else
+   {
+      WeightGrid r2((v1.size() + m - 1) / m, v1.getLayout());  // residual buffer for the next coarser level
+      level_stats.bytes_allocated += r2.allocatedBytes();
+      vIteration(level+1, v1, rhs1, r2, stats);
+      correct(level, w0, rhs0, w1, v1, c_residuals, stats);
+   }
+}
+
+// the solver with the type-erased phis is compiled once into the library
+extern template class BasicMGRITSolver<vector<phiFuncType>>;
+
 #endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "typedefs.h"
+#include "weight_grid.h"
 
 using namespace Eigen;
 using namespace std;
@@ -24,7 +25,10 @@ class MoveGrids {
       void setCoarseningFactor(unsigned int my_m);
 
       listOfWeights project(listOfWeights w0, const listOfWeights& e1) const;
+      void project(WeightGrid& w0, const WeightGrid& e1) const;
+      void projectInPlace(listOfWeights& w0, const listOfWeights& e1) const;
       vector<listOfWeights> restrict(const vector<listOfWeights>& fine_grid_objects) const;
+      WeightGrid restrict(WeightGrid& fine_grid) const;
 
 };
 
@@ -0,0 +1,92 @@
+#ifndef HH_PROPAGATOR_HH
+#define HH_PROPAGATOR_HH
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "typedefs.h"
+#include "weight_grid.h"
+
+using namespace std;
+
+// the MGRIT classes are templates over the propagator that advances the weights of one time step to the next, e.g.
+// BasicRelax<TrainingPropagator<FixedNeuralNetwork<3, 4, 1>>> - they apply it through PropagatorTraits, which by
+// default calls the members
+//    void apply(unsigned int i, const weightType& weights, weightType& result) const
+//    void apply(unsigned int i, const StepView& weights, weightType& result) const
+// that write phi_i(weights) into result, where i is the time step of the weights and the matrices of result may be
+// reused when they already have the right shape - the second one reads the weights straight from a time step of a grid
+template <typename Propagator>
+struct PropagatorTraits {
+
+   static void apply(const Propagator& phi, unsigned int i, const weightType& weights, weightType& result)
+   {
+      phi.apply(i, weights, result);
+   }
+
+   static void apply(const Propagator& phi, unsigned int i, const StepView& weights, weightType& result)
+   {
+      phi.apply(i, weights, result);
+   }
+
+};
+
+// a list of phi functions is the type-erased propagator, where time step i is advanced by phi i modulo the number of phis
+template <>
+struct PropagatorTraits<vector<phiFuncType>> {
+
+   static void apply(const vector<phiFuncType>& phi, unsigned int i, const weightType& weights, weightType& result)
+   {
+      result = phi[i % phi.size()](weights);
+   }
+
+   // the phi functions only take a weightType, so the weights are gathered into result before phi replaces them
+   static void apply(const vector<phiFuncType>& phi, unsigned int i, const StepView& weights, weightType& result)
+   {
+      weights.copyTo(result);
+      result = phi[i % phi.size()](result);
+   }
+
+};
+
+// shares the propagator of a grid level and counts how often it is applied, so copying it only copies two pointers
+template <typename Propagator>
+class CountingPropagator {
+
+   private:
+
+      shared_ptr<atomic<unsigned long>> count;   // number of applications, shared by all copies and threads
+      shared_ptr<const Propagator> phi;          // the propagator that is counted
+
+   public:
+
+      CountingPropagator(Propagator my_phi) : count{make_shared<atomic<unsigned long>>(0)}, 
+                                               phi{make_shared<const Propagator>(move(my_phi))}{}
+
+      // getters
+      unsigned long getCount() const
+      {
+         return count->load();
+      }
+
+      const Propagator& getPropagator() const
+      {
+         return *phi;
+      }
+
+      void apply(unsigned int i, const weightType& weights, weightType& result) const
+      {
+         count->fetch_add(1, memory_order_relaxed);
+         PropagatorTraits<Propagator>::apply(*phi, i, weights, result);
+      }
+
+      void apply(unsigned int i, const StepView& weights, weightType& result) const
+      {
+         count->fetch_add(1, memory_order_relaxed);
+         PropagatorTraits<Propagator>::apply(*phi, i, weights, result);
+      }
+
+};
+
+#endif
\ No newline at end of file
@@ -1,35 +1,302 @@
 #ifndef HH_RELAX_HH
 #define HH_RELAX_HH
 
+#include <algorithm>
 #include <Eigen/Dense>
+#include <memory>
 #include <vector>
 
+#include "propagator.h"
+#include "thread_pool.h"
 #include "typedefs.h"
+#include "weight_grid.h"
 
 using namespace Eigen;
 using namespace std;
 
-class Relax {
+template <typename Propagator>
+class BasicRelax {
 
    private:
 
-      unsigned int m;           // coarsening factor
-      vector<phiFuncType> phi;  // phi functions used to do the relaxation
+      unsigned int m;                 // coarsening factor
+      Propagator phi;                 // propagator used to do the relaxation
+      shared_ptr<ThreadPool> pool;    // worker pool the independent F-intervals are dispatched to
+
+      void applyPhi(unsigned int i, const weightType& weights, weightType& result) const;
+      void applyPhi(unsigned int i, const StepView& weights, weightType& result) const;
+      void relaxInterval(unsigned int interval, WeightGrid& weights, const WeightGrid& rhs, weightType& phi_of_w) const;
 
    public:
 
-      Relax(unsigned int my_m, vector<phiFuncType> my_phi);
+      BasicRelax(unsigned int my_m, Propagator my_phi, unsigned int my_num_threads = 1);
+      BasicRelax(unsigned int my_m, Propagator my_phi, shared_ptr<ThreadPool> my_pool);
 
       // getters and setters
       unsigned int getM() const;
-      vector<phiFuncType> getPhi() const;
-      void setPhi(vector<phiFuncType> my_phi);
+      unsigned int getNumThreads() const;
+      Propagator getPhi() const;
       void setM(unsigned int my_m);
+      void setNumThreads(unsigned int my_num_threads);
+      void setPhi(Propagator my_phi);
 
+      // the overloads taking a range only relax the C-points or the F-intervals [begin, end), where F-interval i starts
+      // at C-point i, so that a caller can relax some of them while it waits for the weights the others depend on
       listOfWeights cRelax(listOfWeights weights, const listOfWeights& rhs) const;
+      void cRelax(WeightGrid& weights, const WeightGrid& rhs) const;
+      void cRelax(WeightGrid& weights, const WeightGrid& rhs, unsigned int begin, unsigned int end) const;
+      void cRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const;
       listOfWeights fcfRelax(listOfWeights weights, const listOfWeights& rhs) const;
+      void fcfRelax(WeightGrid& weights, const WeightGrid& rhs) const;
+      void fcfRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals) const;
+      void fcfRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const;
       listOfWeights fRelax(listOfWeights weights, const listOfWeights& rhs) const;
+      void fRelax(WeightGrid& weights, const WeightGrid& rhs) const;
+      void fRelax(WeightGrid& weights, const WeightGrid& rhs, unsigned int begin, unsigned int end) const;
+      void fRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals) const;
+      void fRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals, unsigned int begin, unsigned int end) const;
+      void fRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const;
 
 };
 
+// the relaxation with a list of phi functions, which can be built at run time
+typedef BasicRelax<vector<phiFuncType>> Relax;
+
+// the class template is implemented in the header, so that it can be instantiated on any propagator
+
+template <typename Propagator>
+void BasicRelax<Propagator>::applyPhi(unsigned int i, const weightType& weights, weightType& result) const
+{
+   PropagatorTraits<Propagator>::apply(phi, i, weights, result);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::applyPhi(unsigned int i, const StepView& weights, weightType& result) const
+{
+   PropagatorTraits<Propagator>::apply(phi, i, weights, result);
+}
+
+template <typename Propagator>
+listOfWeights BasicRelax<Propagator>::cRelax(listOfWeights weights, const listOfWeights& rhs) const
+{
+   cRelaxInPlace(weights, rhs);
+   return weights;
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::cRelax(WeightGrid& weights, const WeightGrid& rhs) const
+{
+   cRelax(weights, rhs, 1, (weights.size() + m - 1) / m);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::cRelax(WeightGrid& weights, const WeightGrid& rhs, unsigned int begin, unsigned int end) const
+{
+   // each C-point only reads the F-point before it, which the C-relaxation does not change, so the C-points are
+   // updated at once in chunks on the same pool as the F-relaxation - the first C-point has no F-point before it
+   pool->parallelForChunks(max(begin, 1u), end, [this, &weights, &rhs](unsigned int chunk_begin, unsigned int chunk_end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = chunk_begin * m; i < chunk_end * m; i += m)
+      {
+         applyPhi(i-1, weights.stepView(i-1), phi_of_w);
+         for (unsigned int l = 0; l < phi_of_w.size(); l++)
+         {
+            weights.layer(i, l) = phi_of_w[l] + rhs.layer(i, l);
+         }
+      }
+   });
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::cRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const
+{
+   // the C-points only read the F-points before them, so they are updated at once as in the WeightGrid overload
+   unsigned int num_c_points = (weights.size() + m - 1) / m;
+   pool->parallelForChunks(1, num_c_points, [this, &weights, &rhs](unsigned int begin, unsigned int end)
+   {
+      weightType phi_of_w;
+      for (unsigned int i = begin * m; i < end * m; i += m)
+      {
+         applyPhi(i-1, weights[i-1], phi_of_w);
+         transform(phi_of_w.begin(), phi_of_w.end(), rhs[i].begin(), weights[i].begin(), plus<MatrixXd>());
+      }
+   });
+}
+
+template <typename Propagator>
+listOfWeights BasicRelax<Propagator>::fcfRelax(listOfWeights weights, const listOfWeights& rhs) const
+{
+   fcfRelaxInPlace(weights, rhs);
+   return weights;
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fcfRelax(WeightGrid& weights, const WeightGrid& rhs) const
+{
+   // three parallel phases, where each phase returns only once all of its updates are done
+   fRelax(weights, rhs);
+   cRelax(weights, rhs);
+   fRelax(weights, rhs);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fcfRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals) const
+{
+   fRelax(weights, rhs);
+   cRelax(weights, rhs);
+   fRelax(weights, rhs, c_residuals);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fcfRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const
+{
+   fRelaxInPlace(weights, rhs);
+   cRelaxInPlace(weights, rhs);
+   fRelaxInPlace(weights, rhs);
+}
+
+template <typename Propagator>
+listOfWeights BasicRelax<Propagator>::fRelax(listOfWeights weights, const listOfWeights& rhs) const
+{
+   fRelaxInPlace(weights, rhs);
+   return weights;
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fRelax(WeightGrid& weights, const WeightGrid& rhs) const
+{
+   fRelax(weights, rhs, 0, (weights.size() + m - 1) / m);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fRelax(WeightGrid& weights, const WeightGrid& rhs, unsigned int begin, unsigned int end) const
+{
+   pool->parallelForChunks(begin, end, [this, &weights, &rhs](unsigned int chunk_begin, unsigned int chunk_end)
+   {
+      weightType phi_of_w;
+      for (unsigned int interval = chunk_begin; interval < chunk_end; interval++)
+      {
+         relaxInterval(interval, weights, rhs, phi_of_w);
+      }
+   });
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals) const
+{
+   fRelax(weights, rhs, c_residuals, 0, (weights.size() + m - 1) / m);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fRelax(WeightGrid& weights, const WeightGrid& rhs, WeightGrid& c_residuals, unsigned int begin, unsigned int end) const
+{
+   // after F-relaxation the residual only remains at the C-points, so each interval carries phi on from its last
+   // F-point to the C-point that follows and stores the residual there in the coarse sized c_residuals
+   // the residual at the first C-point is stored along with the first interval
+   if (begin == 0 and end > 0)
+   {
+      c_residuals.step(0) = rhs.step(0) - weights.step(0);
+   }
+   pool->parallelForChunks(begin, end, [this, &weights, &rhs, &c_residuals](unsigned int chunk_begin, unsigned int chunk_end)
+   {
+      weightType phi_of_w;
+      for (unsigned int interval = chunk_begin; interval < chunk_end; interval++)
+      {
+         relaxInterval(interval, weights, rhs, phi_of_w);
+         unsigned int c_point = (interval + 1) * m;
+         if (c_point < weights.size())
+         {
+            applyPhi(c_point-1, weights.stepView(c_point-1), phi_of_w);
+            for (unsigned int l = 0; l < phi_of_w.size(); l++)
+            {
+               c_residuals.layer(interval+1, l) = rhs.layer(c_point, l) - (weights.layer(c_point, l) - phi_of_w[l]);
+            }
+         }
+      }
+   });
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::fRelaxInPlace(listOfWeights& weights, const listOfWeights& rhs) const
+{
+   // the F-intervals [i, i+m) only read their own C-point, so each one can be relaxed on a different thread
+   unsigned int num_intervals = (weights.size() + m - 1) / m;
+   pool->parallelFor(0, num_intervals, [this, &weights, &rhs](unsigned int interval)
+   {
+      int i = interval * m;
+      weightType phi_of_w;
+      for (int j = i+1; j < i+m and j < weights.size(); j++)
+      {
+         applyPhi(j-1, weights[j-1], phi_of_w);
+         transform(phi_of_w.begin(), phi_of_w.end(), rhs[j].begin(), weights[j].begin(), plus<MatrixXd>());
+      }
+   });
+}
+
+template <typename Propagator>
+unsigned int BasicRelax<Propagator>::getM() const
+{
+   return m;
+}
+
+template <typename Propagator>
+unsigned int BasicRelax<Propagator>::getNumThreads() const
+{
+   return pool->getNumThreads();
+}
+
+template <typename Propagator>
+Propagator BasicRelax<Propagator>::getPhi() const
+{
+   return phi;
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::relaxInterval(unsigned int interval, WeightGrid& weights, const WeightGrid& rhs, weightType& phi_of_w) const
+{
+   // phi reads the previous step straight from the grid and writes into the buffer of the caller
+   unsigned int i = interval * m;
+   for (unsigned int j = i+1; j < i+m and j < weights.size(); j++)
+   {
+      applyPhi(j-1, weights.stepView(j-1), phi_of_w);
+      for (unsigned int l = 0; l < phi_of_w.size(); l++)
+      {
+         weights.layer(j, l) = phi_of_w[l] + rhs.layer(j, l);
+      }
+   }
+}
+
+template <typename Propagator>
+BasicRelax<Propagator>::BasicRelax(unsigned int my_m, Propagator my_phi, unsigned int my_num_threads) : m{my_m}, 
+                                                                                                     phi{move(my_phi)}, 
+                                                                                                     pool{make_shared<ThreadPool>(my_num_threads)}{}
+
+template <typename Propagator>
+BasicRelax<Propagator>::BasicRelax(unsigned int my_m, Propagator my_phi, shared_ptr<ThreadPool> my_pool) : m{my_m}, 
+                                                                                                           phi{move(my_phi)}, 
+                                                                                                           pool{my_pool}{}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::setM(unsigned int my_m)
+{
+   m = my_m;
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::setNumThreads(unsigned int my_num_threads)
+{
+   pool = make_shared<ThreadPool>(my_num_threads);
+}
+
+template <typename Propagator>
+void BasicRelax<Propagator>::setPhi(Propagator my_phi)
+{
+   phi = move(my_phi);
+}
+
+// the relaxations with the type-erased phis are compiled once into the library
+extern template class BasicRelax<vector<phiFuncType>>;
+extern template class BasicRelax<CountingPropagator<vector<phiFuncType>>>;
+
 #endif
\ No newline at end of file
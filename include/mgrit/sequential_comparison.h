@@ -0,0 +1,74 @@
+#ifndef HH_SEQUENTIAL_COMPARISON_HH
+#define HH_SEQUENTIAL_COMPARISON_HH
+
+#include <ostream>
+#include <vector>
+
+#include "mgrit_helper.h"
+#include "mgrit_solver.h"
+#include "solver_stats.h"
+#include "typedefs.h"
+#include "weight_grid.h"
+
+using namespace std;
+
+// timings of an MGRIT solve with a given number of threads against plain sequential time stepping over the same steps
+struct SequentialComparison {
+
+   unsigned int num_threads = 1;                // number of threads MGRIT ran on
+   double mgrit_time = 0.0;                     // seconds MGRIT took to converge
+   double sequential_time = 0.0;                // seconds the forward solve on the finest level took
+   unsigned long mgrit_phi_evaluations = 0;     // number of phi applications on all levels of MGRIT
+   unsigned long sequential_phi_evaluations = 0;// number of phi applications of the forward solve
+   double weight_difference = 0.0;              // euclidean norm of the difference between the final weights of both
+
+   double speedup() const;
+
+};
+
+// runs the solver to the given tolerance once for each thread count and the sequential forward solve with the phis of the
+// finest level once, since it does not depend on the number of threads - the solver is taken by value, so the settings
+// of the caller's solver are left untouched
+template <typename Propagator>
+vector<SequentialComparison> compareToSequential(BasicMGRITSolver<Propagator> solver, const WeightGrid& w0, const WeightGrid& rhs0, const double& tol, const bool& f_cycle, const vector<unsigned int>& thread_counts);
+void writeComparison(ostream& out, const vector<SequentialComparison>& comparisons);
+
+// template function must be implemented in the header
+template <typename Propagator>
+vector<SequentialComparison> compareToSequential(BasicMGRITSolver<Propagator> solver, const WeightGrid& w0, const WeightGrid& rhs0, const double& tol, const bool& f_cycle, const vector<unsigned int>& thread_counts)
+{
+
+   // train the weights in a sequential fashion, which is the forward solve on the finest level
+   BasicMGRITHelper<Propagator> helper(solver.getPhis()[0]);
+   WeightGrid sequential_weights(rhs0.size(), rhs0.getLayout());
+   statsClock::time_point start = statsClock::now();
+   helper.forwardSolve(rhs0, sequential_weights);
+   double sequential_time = secondsSince(start);
+   const unsigned int last_step = rhs0.size() - 1;
+
+   // run MGRIT on each number of threads
+   vector<SequentialComparison> comparisons;
+   solver.setDisplayStats(false);
+   for (const unsigned int& num_threads : thread_counts)
+   {
+      solver.setNumThreads(num_threads);
+      WeightGrid mgrit_weights = w0;
+      SolverStats stats = solver.run(mgrit_weights, rhs0, tol, f_cycle);
+
+      SequentialComparison comparison;
+      comparison.num_threads = num_threads;
+      comparison.mgrit_time = stats.total_time;
+      comparison.sequential_time = sequential_time;
+      for (const LevelStats& level : stats.levels)
+      {
+         comparison.mgrit_phi_evaluations += level.phi_evaluations;
+      }
+      comparison.sequential_phi_evaluations = last_step;
+      comparison.weight_difference = (mgrit_weights.step(last_step) - sequential_weights.step(last_step)).norm();
+      comparisons.push_back(comparison);
+   }
+
+   return comparisons;
+}
+
+#endif
\ No newline at end of file
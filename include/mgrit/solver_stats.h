@@ -0,0 +1,48 @@
+#ifndef HH_SOLVER_STATS_HH
+#define HH_SOLVER_STATS_HH
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+typedef chrono::steady_clock statsClock;
+
+// time spent in each phase of the MGRIT cycles on one grid level together with the work done on that level
+// the time of a phase only covers the work on its own level, the coarser levels a cycle recurses to are recorded separately
+struct LevelStats {
+
+   unsigned int cycles = 0;              // number of V or F cycles started on the level
+   double fcf_relax_time = 0.0;          // seconds spent in FCF-relaxation
+   double f_relax_time = 0.0;            // seconds spent in F-relaxation
+   double residual_time = 0.0;           // seconds spent computing residual norms and the rhs of the next coarser level
+   double restrict_time = 0.0;           // seconds spent restricting the weights and copying them onto the coarse level
+   double coarse_solve_time = 0.0;       // seconds spent in the serial forward solve, only nonzero on the coarsest level
+   double project_time = 0.0;            // seconds spent computing the coarse error and projecting it to the fine level
+   double wait_time = 0.0;               // seconds the distributed solver waited for the slab on the left, part of the relaxation times
+   unsigned long phi_evaluations = 0;    // number of times a phi function of the level was applied
+   size_t bytes_allocated = 0;           // bytes of weight grids allocated for the level's cycles
+
+   double totalTime() const;
+
+};
+
+// report of one MGRITSolver::run, which can be written out as JSON or as CSV with one row per level
+struct SolverStats {
+
+   unsigned int iterations = 0;          // number of cycles run on the finest level
+   vector<double> residual_norms;        // initial norm of the residual followed by its norm after each iteration
+   double convergence_rate = 0.0;        // average factor the residual norm was reduced by per iteration
+   double total_time = 0.0;              // seconds spent in the whole run
+   vector<LevelStats> levels;            // stats for each grid level, starting with the finest
+
+   void writeCSV(ostream& out) const;
+   void writeJSON(ostream& out) const;
+
+};
+
+double secondsSince(const statsClock::time_point& start);
+
+#endif
\ No newline at end of file
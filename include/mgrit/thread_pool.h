@@ -0,0 +1,44 @@
+#ifndef HH_THREAD_POOL_HH
+#define HH_THREAD_POOL_HH
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool {
+
+   private:
+
+      unsigned int num_threads;              // number of threads that work on a loop, including the calling thread
+      condition_variable queue_condition;    // wakes up the workers when a task is queued or the pool is stopped
+      mutex queue_mutex;                     // guards the task queue and the stop flag
+      bool stop = false;                     // tells the workers to exit once the queue is empty
+      queue<function<void()>> tasks;         // tasks waiting to be picked up by a worker
+      vector<thread> workers;                // worker threads owned by the pool
+
+      void workerLoop();
+
+   public:
+
+      ThreadPool(unsigned int my_num_threads = 1);
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+      ~ThreadPool();
+
+      // getters
+      unsigned int getNumThreads() const;
+
+      void parallelFor(unsigned int begin, unsigned int end, const function<void (unsigned int)>& body);
+
+      // static scheduling for short loop bodies, where each thread gets one contiguous chunk [chunk_begin, chunk_end)
+      // of the range, so the threads claim work once per chunk instead of once per index
+      void parallelForChunks(unsigned int begin, unsigned int end, const function<void (unsigned int, unsigned int)>& body);
+
+};
+
+#endif
\ No newline at end of file
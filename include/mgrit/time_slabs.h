@@ -0,0 +1,38 @@
+#ifndef HH_TIME_SLABS_HH
+#define HH_TIME_SLABS_HH
+
+using namespace std;
+
+// splits the time points of the finest grid into contiguous slabs, one for each process of a distributed solver
+// the slabs start at C-points, so that every F-interval lies within a single slab, and get the same number of
+// F-intervals up to one, where slabs are empty when there are fewer F-intervals than slabs
+class TimeSlabs {
+
+   private:
+
+      unsigned int m;            // coarsening factor
+      unsigned int num_points;   // number of time points of the finest grid
+      unsigned int num_slabs;    // number of slabs the time points are split into
+
+      unsigned int firstInterval(unsigned int slab) const;
+
+   public:
+
+      TimeSlabs(unsigned int my_num_points, unsigned int my_m, unsigned int my_num_slabs);
+
+      // getters
+      unsigned int getCoarseningFactor() const;
+      unsigned int getNumPoints() const;
+      unsigned int getNumSlabs() const;
+
+      // the time points [begin, end) of a slab on the finest grid, and its C-points counted on the coarse grid
+      unsigned int begin(unsigned int slab) const;
+      unsigned int coarseBegin(unsigned int slab) const;
+      unsigned int coarseSize(unsigned int slab) const;
+      unsigned int end(unsigned int slab) const;
+      unsigned int numIntervals() const;
+      unsigned int size(unsigned int slab) const;
+
+};
+
+#endif
\ No newline at end of file
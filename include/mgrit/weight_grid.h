@@ -0,0 +1,105 @@
+#ifndef HH_WEIGHT_GRID_HH
+#define HH_WEIGHT_GRID_HH
+
+#include <cstddef>
+#include <Eigen/Dense>
+#include <memory>
+#include <vector>
+
+#include "typedefs.h"
+
+using namespace Eigen;
+using namespace std;
+
+// shapes of the layers of one set of weights and where each layer starts inside a time step
+class WeightLayout {
+
+   private:
+
+      vector<Index> cols;      // number of columns of each layer
+      vector<Index> offsets;   // offset of the first entry of each layer from the start of the time step
+      vector<Index> rows;      // number of rows of each layer
+      Index step_size = 0;     // number of doubles in one time step
+
+   public:
+
+      WeightLayout(const weightType& weights);
+
+      // getters
+      Index getCols(unsigned int layer) const;
+      unsigned int getNumLayers() const;
+      Index getOffset(unsigned int layer) const;
+      Index getRows(unsigned int layer) const;
+      Index getStepSize() const;
+
+      bool operator==(const WeightLayout& other) const;
+
+};
+
+// a non-owning view onto the layers of one time step of a grid, which reads like a weightType, so that a propagator
+// can read the weights of a time step without copying them out of the grid first
+class StepView {
+
+   private:
+
+      const double* data;              // start of the time step
+      const WeightLayout* layout;      // layer shapes of the grid the time step belongs to
+
+   public:
+
+      StepView(const double* my_data, const WeightLayout* my_layout);
+
+      void copyTo(weightType& weights) const;
+      unsigned int size() const;
+
+      Map<const MatrixXd> operator[](unsigned int l) const;
+
+};
+
+// all time steps of an MGRIT grid stored back to back in a single buffer
+// a grid can also be a non-owning, strided view onto every k-th time step of another grid - copying a view always
+// produces a contiguous grid that owns its data, while moving it keeps it a view
+class WeightGrid {
+
+   private:
+
+      double* data = nullptr;                 // start of the first time step
+      shared_ptr<const WeightLayout> layout;  // layer shapes shared by every time step
+      unsigned int num_steps = 0;             // number of time steps in the grid
+      Index step_stride = 0;                  // number of doubles between the starts of two consecutive time steps
+      vector<double> storage;                 // buffer owned by the grid, empty for a view
+
+      void copyFrom(const WeightGrid& other);
+
+   public:
+
+      WeightGrid() = default;
+      explicit WeightGrid(const listOfWeights& weights);
+      WeightGrid(unsigned int my_num_steps, shared_ptr<const WeightLayout> my_layout);
+      WeightGrid(const WeightGrid& other);
+      WeightGrid(WeightGrid&& other);
+      WeightGrid& operator=(const WeightGrid& other);
+      WeightGrid& operator=(WeightGrid&& other);
+
+      // getters
+      shared_ptr<const WeightLayout> getLayout() const;
+      weightType getStep(unsigned int i) const;
+      void setStep(unsigned int i, const weightType& weights);
+
+      // views onto a single time step or onto one layer of a time step
+      Map<MatrixXd> layer(unsigned int i, unsigned int l);
+      Map<const MatrixXd> layer(unsigned int i, unsigned int l) const;
+      Map<VectorXd> step(unsigned int i);
+      Map<const VectorXd> step(unsigned int i) const;
+      StepView stepView(unsigned int i) const;
+
+      size_t allocatedBytes() const;
+      void copyStep(unsigned int i, weightType& weights) const;
+      bool isView() const;
+      unsigned int size() const;
+      WeightGrid stridedView(unsigned int stride);
+      listOfWeights toList() const;
+
+};
+
+#endif
\ No newline at end of file
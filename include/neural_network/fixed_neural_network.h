@@ -0,0 +1,215 @@
+#ifndef HH_FIXED_NEURAL_NETWORK_HH
+#define HH_FIXED_NEURAL_NETWORK_HH
+
+#include <Eigen/Dense>
+#include <stdexcept>
+#include <vector>
+
+#include "typedefs.h"
+
+using namespace Eigen;
+using namespace std;
+
+// layers with at most this many weights are stored in fixed-size Eigen matrices, larger layers fall back to dynamic
+// storage so that they neither blow up the stack nor the size of the generated code
+const int max_fixed_layer_size = 256;
+
+// a single layer mapping Inputs nodes to Outputs nodes together with the buffers used to train it
+// the number of rows of a batch is only known at run time, so the node values have a dynamic number of rows
+template <int Inputs, int Outputs>
+class FixedLayer {
+
+   public:
+
+      typedef Matrix<double, Inputs * Outputs <= max_fixed_layer_size ? Inputs : Dynamic, Inputs * Outputs <= max_fixed_layer_size ? Outputs : Dynamic> WeightMatrix;
+      typedef Matrix<double, Dynamic, Inputs> InputMatrix;
+      typedef Matrix<double, Dynamic, Outputs> OutputMatrix;
+
+   protected:
+
+      WeightMatrix weight{Inputs, Outputs};   // weights of the layer when the network holds its own weights
+      OutputMatrix deltas;                    // error of the layer scaled by the derivative of the activation function
+      OutputMatrix errors;                    // error at the output of the layer
+      OutputMatrix node_values;               // values of the nodes at the output of the layer
+      WeightMatrix update{Inputs, Outputs};   // change applied to the weights of the layer
+
+      // the weights are either the member of the layer or a map onto a weight matrix of the caller
+      // the error at the output of the layer must be set before the weights are updated
+      // the error at the input of the layer is only computed when input_errors is not null
+      template <typename Weight>
+      void backpropagate(const Ref<const InputMatrix>& input, Weight& layer_weight, const double& alpha, InputMatrix* input_errors)
+      {
+         deltas = errors.array() * (node_values.array() * (1.0 - node_values.array()));
+         if (input_errors) {input_errors->noalias() = deltas * layer_weight.transpose();}
+         update.noalias() = alpha * input.transpose() * deltas;
+         layer_weight += update;
+      }
+
+      template <typename Weight>
+      void feedForward(const Ref<const InputMatrix>& input, const Weight& layer_weight)
+      {
+         node_values.noalias() = input * layer_weight;
+         node_values = 1.0 / (1.0 + (-1.0 * node_values).array().exp());
+      }
+
+   public:
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+};
+
+// the layers of a network with the given numbers of nodes per layer, built up by recursion over the remaining layers
+template <int Inputs, int Outputs, int... Rest>
+class FixedLayers : public FixedLayer<Inputs, Outputs> {
+
+   private:
+
+      FixedLayers<Outputs, Rest...> next;   // the layers following this one
+
+   public:
+
+      void getWeights(weightType& weights, unsigned int l = 0) const
+      {
+         weights[l] = this->weight;
+         next.getWeights(weights, l + 1);
+      }
+
+      void setWeights(const weightType& weights, unsigned int l = 0)
+      {
+         this->weight = weights[l];
+         next.setWeights(weights, l + 1);
+      }
+
+      void train(const Ref<const typename FixedLayer<Inputs, Outputs>::InputMatrix>& input, const MatrixXd& target, const double& alpha, typename FixedLayer<Inputs, Outputs>::InputMatrix* input_errors = nullptr)
+      {
+         this->feedForward(input, this->weight);
+         next.train(this->node_values, target, alpha, &this->errors);
+         this->backpropagate(input, this->weight, alpha, input_errors);
+      }
+
+      // trains the weight matrices of the caller in place, where matrix l belongs to this layer
+      void train(weightType& weights, const Ref<const typename FixedLayer<Inputs, Outputs>::InputMatrix>& input, const MatrixXd& target, const double& alpha, typename FixedLayer<Inputs, Outputs>::InputMatrix* input_errors = nullptr, unsigned int l = 0)
+      {
+         Map<typename FixedLayer<Inputs, Outputs>::WeightMatrix> layer_weight(weights[l].data(), Inputs, Outputs);
+         this->feedForward(input, layer_weight);
+         next.train(weights, this->node_values, target, alpha, &this->errors, l + 1);
+         this->backpropagate(input, layer_weight, alpha, input_errors);
+      }
+
+};
+
+// the output layer of the network
+template <int Inputs, int Outputs>
+class FixedLayers<Inputs, Outputs> : public FixedLayer<Inputs, Outputs> {
+
+   public:
+
+      void getWeights(weightType& weights, unsigned int l = 0) const
+      {
+         weights[l] = this->weight;
+      }
+
+      void setWeights(const weightType& weights, unsigned int l = 0)
+      {
+         this->weight = weights[l];
+      }
+
+      void train(const Ref<const typename FixedLayer<Inputs, Outputs>::InputMatrix>& input, const MatrixXd& target, const double& alpha, typename FixedLayer<Inputs, Outputs>::InputMatrix* input_errors = nullptr)
+      {
+         this->feedForward(input, this->weight);
+         this->errors = target - this->node_values;
+         this->backpropagate(input, this->weight, alpha, input_errors);
+      }
+
+      void train(weightType& weights, const Ref<const typename FixedLayer<Inputs, Outputs>::InputMatrix>& input, const MatrixXd& target, const double& alpha, typename FixedLayer<Inputs, Outputs>::InputMatrix* input_errors = nullptr, unsigned int l = 0)
+      {
+         Map<typename FixedLayer<Inputs, Outputs>::WeightMatrix> layer_weight(weights[l].data(), Inputs, Outputs);
+         this->feedForward(input, layer_weight);
+         this->errors = target - this->node_values;
+         this->backpropagate(input, layer_weight, alpha, input_errors);
+      }
+
+};
+
+// a nn whose layer sizes are fixed at compile time, e.g. FixedNeuralNetwork<3, 4, 1> has a 3x4 and a 4x1 layer
+// it trains the same way as NeuralNetwork and takes and returns the weights as a weightType, so its propagate can be
+// used in the phi functions of the MGRIT classes in place of NeuralNetwork::propagate
+template <int... LayerSizes>
+class FixedNeuralNetwork {
+
+   private:
+
+      float alpha;                        // the learning rate of the nn
+      FixedLayers<LayerSizes...> layers;  // weights of the network and the buffers reused by every call to train
+
+      // the layers read the weights as matrices of a fixed size, so weights of any other shape are rejected up front
+      static void checkWeights(const weightType& weights)
+      {
+         const int layer_sizes[] = {LayerSizes...};
+         bool fits = weights.size() == num_layers;
+         for (unsigned int l = 0; fits and l < num_layers; l++)
+         {
+            fits = weights[l].rows() == layer_sizes[l] and weights[l].cols() == layer_sizes[l+1];
+         }
+         if (!fits) {throw invalid_argument("The weights do not match the layer sizes of the nn");}
+      }
+
+   public:
+
+      static const unsigned int num_layers = sizeof...(LayerSizes) - 1;   // number of weight matrices of the network
+
+      FixedNeuralNetwork(float my_alpha, const weightType& my_weights) : alpha{my_alpha}
+      {
+         checkWeights(my_weights);
+         layers.setWeights(my_weights);
+      }
+
+      // getters and setters
+      float getAlpha() const
+      {
+         return alpha;
+      }
+
+      weightType getWeights() const
+      {
+         weightType weights(num_layers);
+         layers.getWeights(weights);
+         return weights;
+      }
+
+      void setAlpha(float my_alpha)
+      {
+         alpha = my_alpha;
+      }
+
+      void setWeights(const weightType& my_weights)
+      {
+         checkWeights(my_weights);
+         layers.setWeights(my_weights);
+      }
+
+      static weightType propagate(weightType weights, const MatrixXd& input, const MatrixXd& target, const float& alpha)
+      {
+         propagateInPlace(weights, input, target, alpha);
+         return weights;
+      }
+
+      static void propagateInPlace(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha)
+      {
+         // every thread keeps its own buffers, so concurrent calls share no state, while the weights are trained where
+         // they are instead of being copied into the layers and back
+         static thread_local FixedLayers<LayerSizes...> thread_layers;
+         checkWeights(weights);
+         thread_layers.train(weights, input, target, alpha);
+      }
+
+      void train(const MatrixXd& input, const MatrixXd& target)
+      {
+         layers.train(input, target, alpha);
+      }
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+};
+
+#endif
\ No newline at end of file
@@ -2,7 +2,6 @@
 #define HH_NEURAL_NETWORK_HH
 
 #include <Eigen/Dense>
-#include <stack>
 #include <vector>
 
 #include "typedefs.h"
@@ -10,14 +9,35 @@
 using namespace Eigen;
 using namespace std;
 
+// buffers for the intermediate values of a training step, sized from the layer shapes and the number of input rows
+// once a workspace has been used for a given network and batch size, training with it allocates no memory
+class NetworkWorkspace {
+
+   private:
+
+      vector<MatrixXd> deltas;        // error of each layer scaled by the derivative of the activation function
+      vector<MatrixXd> errors;        // error at the output of each layer
+      vector<MatrixXd> node_values;   // values of the nodes at the output of each layer
+      vector<MatrixXd> updates;       // change applied to the weights of each layer
+
+   public:
+
+      void resize(const weightType& weights, const Index& batch_size);
+
+      friend class NeuralNetwork;
+
+};
+
 class NeuralNetwork {
 
    private:
 
-      float alpha;              // the learning rate of the nn
-      weightType weights;       // weights of the network
+      float alpha;                    // the learning rate of the nn
+      weightType weights;             // weights of the network
+      NetworkWorkspace workspace;     // buffers reused by every call to train
 
-      MatrixXd sigmoid(const MatrixXd& x, const bool& derivative) const;
+      static void sigmoid(MatrixXd& x);
+      static void trainWeights(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha, NetworkWorkspace& workspace);
    
    public:
 
@@ -29,6 +49,9 @@ class NeuralNetwork {
       void setAlpha(float my_alpha);
       void setWeights(weightType my_weights);
 
+      static weightType propagate(weightType weights, const MatrixXd& input, const MatrixXd& target, const float& alpha);
+      static void propagate(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha, NetworkWorkspace& workspace);
+      static void propagateInPlace(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha);
       void train(const MatrixXd& input, const MatrixXd& target);
       
 };
@@ -0,0 +1,44 @@
+#ifndef HH_PHI_GENERATOR_HH
+#define HH_PHI_GENERATOR_HH
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "neural_network.h"
+#include "training_propagator.h"
+#include "typedefs.h"
+
+using namespace Eigen;
+using namespace std;
+
+// the training data is split into mini-batches of batch_size consecutive rows, where the last batch holds whatever rows
+// are left - a batch size of 1 trains the nn in a serial fashion and a batch size of at least the number of rows trains
+// it on the whole data set at once - the batch size must be at least 1
+// the propagator trains the weights on one batch, e.g. FixedNeuralNetwork<3, 4, 1>::propagate for a nn of known shape
+vector<vector<phiFuncType>> generatePhis(const MatrixXd& input, const MatrixXd& target, const float& base_alpha, const float& max_alpha, const unsigned int& max_level, const unsigned int& batch_size, propagatorType propagator = NeuralNetwork::propagate);
+float levelAlpha(const float& base_alpha, const float& max_alpha, const unsigned int& level);
+MatrixXd miniBatch(const MatrixXd& data, const unsigned int& batch, const unsigned int& batch_size);
+unsigned int numMiniBatches(const MatrixXd& data, const unsigned int& batch_size);
+
+// the same phis as generatePhis as a concrete propagator on each level, which the MGRIT classes apply without going
+// through std::function, e.g. generatePropagators<FixedNeuralNetwork<3, 4, 1>> for a BasicMGRITSolver
+template <typename Network>
+vector<TrainingPropagator<Network>> generatePropagators(const MatrixXd& input, const MatrixXd& target, const float& base_alpha, const float& max_alpha, const unsigned int& max_level, const unsigned int& batch_size)
+{
+   vector<MatrixXd> batch_inputs;
+   vector<MatrixXd> batch_targets;
+   for (unsigned int j = 0; j < numMiniBatches(input, batch_size); j++)
+   {
+      batch_inputs.push_back(miniBatch(input, j, batch_size));
+      batch_targets.push_back(miniBatch(target, j, batch_size));
+   }
+
+   vector<TrainingPropagator<Network>> propagators;
+   for (unsigned int i = 0; i < max_level; i++)
+   {
+      propagators.push_back(TrainingPropagator<Network>(levelAlpha(base_alpha, max_alpha, i), batch_inputs, batch_targets));
+   }
+   return propagators;
+}
+
+#endif
\ No newline at end of file
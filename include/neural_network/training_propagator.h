@@ -0,0 +1,58 @@
+#ifndef HH_TRAINING_PROPAGATOR_HH
+#define HH_TRAINING_PROPAGATOR_HH
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "typedefs.h"
+#include "weight_grid.h"
+
+using namespace Eigen;
+using namespace std;
+
+// a propagator for the MGRIT classes that trains the weights on one mini-batch per time step, cycling through the
+// batches - Network is NeuralNetwork or a FixedNeuralNetwork, whose propagateInPlace trains the weights in place, so
+// the trained weights are written straight into the buffer of the caller
+template <typename Network>
+class TrainingPropagator {
+
+   private:
+
+      float alpha;                       // learning rate used on the grid level of the propagator
+      vector<MatrixXd> batch_inputs;     // training input of each mini-batch
+      vector<MatrixXd> batch_targets;    // training target of each mini-batch
+
+   public:
+
+      TrainingPropagator(float my_alpha, vector<MatrixXd> my_batch_inputs, vector<MatrixXd> my_batch_targets) : alpha{my_alpha}, 
+                                                                                                                batch_inputs{my_batch_inputs}, 
+                                                                                                                batch_targets{my_batch_targets}{}
+
+      // getters
+      float getAlpha() const
+      {
+         return alpha;
+      }
+
+      unsigned int size() const
+      {
+         return batch_inputs.size();
+      }
+
+      void apply(unsigned int i, const weightType& weights, weightType& result) const
+      {
+         unsigned int batch = i % batch_inputs.size();
+         result = weights;
+         Network::propagateInPlace(result, batch_inputs[batch], batch_targets[batch], alpha);
+      }
+
+      void apply(unsigned int i, const StepView& weights, weightType& result) const
+      {
+         unsigned int batch = i % batch_inputs.size();
+         weights.copyTo(result);
+         Network::propagateInPlace(result, batch_inputs[batch], batch_targets[batch], alpha);
+      }
+
+};
+
+#endif
\ No newline at end of file
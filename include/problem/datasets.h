@@ -0,0 +1,30 @@
+#ifndef HH_DATASETS_HH
+#define HH_DATASETS_HH
+
+#include <Eigen/Dense>
+#include <string>
+#include <vector>
+
+#include "typedefs.h"
+
+using namespace Eigen;
+using namespace std;
+
+// each dataset is returned as {input, target} with one training row per row of the matrices
+
+// the sum of two random bits-bit numbers modulo 2^bits, with both numbers as input and the sum as target in binary
+vector<MatrixXd> binaryAdditionData(const unsigned int& bits = 12, const unsigned int& num_rows = 500, const unsigned int& seed = 2);
+
+// xor, binary_addition or the path to a csv file - the number of inputs and targets is taken from the first and last layer
+vector<MatrixXd> loadDataset(const string& dataset, const vector<Index>& layers);
+
+// random weights of a nn with the given number of nodes in each layer
+weightType randomWeights(const vector<Index>& layers);
+
+// each line holds the num_inputs inputs of a row followed by its targets, separated by commas
+vector<MatrixXd> readCSVData(const string& path, const Index& num_inputs);
+
+// the xor of the first two of three inputs, where the third input is always 1
+vector<MatrixXd> xorData();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef HH_PROBLEM_CONFIG_HH
+#define HH_PROBLEM_CONFIG_HH
+
+#include <Eigen/Dense>
+#include <string>
+#include <vector>
+
+using namespace Eigen;
+using namespace std;
+
+// parameters of a training problem solved with MGRIT, which are read from the command line or a config file
+struct ProblemConfig {
+
+   unsigned int N = 100;                          // number of training steps
+   unsigned int m = 2;                            // coarsening factor
+   unsigned int max_level = 10;                   // the maximum level the MGRIT algorithm recurses to
+   unsigned int max_coarse_size = 0;              // if not 0, max_level is chosen so that the coarsest grid has at most this many time points
+   float alpha_b = 0.1;                           // the learning rate of the neural network on the fine grid
+   float alpha_max = 30.0;                        // the maximum learning rate the algorithm can increase to on the coarse grids
+   unsigned int batch_size = 1;                   // number of training rows each phi trains on
+   bool f_cycles = true;                          // determine whether to run F cycles (if false, the algorithm runs V cycles)
+   bool display_output = true;                    // displays stats about the MGRIT algorithm as it is running
+   unsigned int num_threads = 1;                  // number of threads the phi functions are applied on in parallel
+   bool pipeline_coarse_solve = true;             // overlaps the coarsest forward solve with the F-relaxation above it on several threads
+   vector<unsigned int> comparison_threads;       // numbers of threads to time MGRIT against sequential training on
+   vector<Index> layers = {3, 4, 1};              // number of nodes in each layer of the nn, starting with the inputs
+   string dataset = "xor";                        // xor, binary_addition or the path to a csv file of inputs and targets
+   bool print_weights = true;                     // prints the final weights of MGRIT and of sequential training
+   string stats_file;                             // file the solver stats are written to, as JSON if it ends in .json and as CSV otherwise
+
+};
+
+// the settings use the names of the fields above, e.g. --max_level=5 or max_level = 5 in a config file, where lists are
+// comma separated and booleans are true/false or 1/0 - the problem setting resets everything to the named preset
+// (three_layer or four_layer) and the config setting reads a config file, both before any other setting is applied
+// invalid settings throw an invalid_argument exception
+void applySetting(ProblemConfig& config, const string& key, const string& value);
+ProblemConfig parseArguments(int argc, char* argv[]);
+ProblemConfig problemPreset(const string& problem);
+void readConfigFile(ProblemConfig& config, const string& path);
+string usage(const string& program);
+
+#endif
\ No newline at end of file
@@ -11,5 +11,6 @@ using namespace std;
 typedef vector<MatrixXd> weightType;
 typedef vector<weightType> listOfWeights;
 typedef function<weightType (const weightType& weights)> phiFuncType;
+typedef weightType (*propagatorType)(weightType weights, const MatrixXd& input, const MatrixXd& target, const float& alpha);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#!/bin/bash
+# builds the project with profile guided optimization and reports the gain over a plain release build
+#
+# usage: scripts/pgo_build.sh [build root] [extra cmake arguments...]
+#
+# the build root (default build-pgo) gets two build directories:
+#   baseline   a release build without profiles
+#   pgo        the instrumented build, which records its profiles with the pgo_train target and is then rebuilt with them
+# the gain is measured on mgrit_problem itself, whose template instantiations are the code the profiles were recorded
+# for - Multigrid_bench instantiates the templates in its own translation units, which get no profiles
+
+set -e
+
+source_dir="$(cd "$(dirname "$0")/.." && pwd)"
+build_root="$(mkdir -p "${1:-build-pgo}" && cd "${1:-build-pgo}" && pwd)"
+shift || true
+jobs="$(nproc 2>/dev/null || echo 1)"
+
+echo "=== building the baseline"
+cmake -S "$source_dir" -B "$build_root/baseline" -DCMAKE_BUILD_TYPE=Release -DMULTIGRID_PGO=OFF "$@" > /dev/null
+cmake --build "$build_root/baseline" -j "$jobs" > /dev/null
+
+echo "=== building the instrumented code and recording the profiles"
+rm -rf "$build_root/pgo/pgo_profiles"
+cmake -S "$source_dir" -B "$build_root/pgo" -DCMAKE_BUILD_TYPE=Release -DMULTIGRID_PGO=GENERATE "$@" > /dev/null
+cmake --build "$build_root/pgo" -j "$jobs" --target mgrit_problem > /dev/null
+cmake --build "$build_root/pgo" --target pgo_train > /dev/null
+
+echo "=== rebuilding with the profiles"
+cmake -S "$source_dir" -B "$build_root/pgo" -DMULTIGRID_PGO=USE > /dev/null
+cmake --build "$build_root/pgo" -j "$jobs" > /dev/null
+
+echo "=== gain of profile guided optimization"
+
+# the best of a few runs of each problem, which is less noisy than a single run
+best_time()
+{
+   best=""
+   for run in 1 2 3; do
+      start=$(date +%s.%N)
+      "$@" > /dev/null
+      end=$(date +%s.%N)
+      best=$(awk -v best="$best" -v time="$(awk -v s="$start" -v e="$end" 'BEGIN {print e - s}')" 'BEGIN {print (best == "" || time < best) ? time : best}')
+   done
+   echo "$best"
+}
+
+printf "%-45s %12s %12s %9s\n" "problem" "baseline" "pgo" "speedup"
+for problem in "--problem=three_layer --N=20000" "--problem=four_layer" "--problem=four_layer --num_threads=2"; do
+   baseline_time=$(best_time "$build_root/baseline/src/mgrit_problem" $problem --display_output=false --print_weights=false)
+   pgo_time=$(best_time "$build_root/pgo/src/mgrit_problem" $problem --display_output=false --print_weights=false)
+   awk -v problem="$problem" -v baseline="$baseline_time" -v pgo="$pgo_time" 'BEGIN {printf "%-45s %11.4gs %11.4gs %8.3fx\n", problem, baseline, pgo, baseline / pgo}'
+done
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "distributed_mgrit_solver.h"
+
+template class BasicDistributedMGRITSolver<vector<phiFuncType>>;
\ No newline at end of file
@@ -8,12 +8,25 @@ unsigned int MoveGrids::getCoarseningFactor() const
 MoveGrids::MoveGrids(unsigned int my_m) : m{my_m}{}
 
 listOfWeights MoveGrids::project(listOfWeights w0, const listOfWeights& e1) const
+{
+   projectInPlace(w0, e1);
+   return w0;
+}
+
+void MoveGrids::project(WeightGrid& w0, const WeightGrid& e1) const
+{
+   for (unsigned int i = 0; i < e1.size(); i++)
+   {
+      w0.step(i*m) += e1.step(i);
+   }
+}
+
+void MoveGrids::projectInPlace(listOfWeights& w0, const listOfWeights& e1) const
 {
    for (int i = 0; i < e1.size(); i++)
    {
       transform(w0[i*m].begin(), w0[i*m].end(), e1[i].begin(), w0[i*m].begin(), plus<MatrixXd>());
    }
-   return w0;
 }
 
 vector<listOfWeights> MoveGrids::restrict(const vector<listOfWeights>& fine_grid_objects) const
@@ -35,6 +48,12 @@ vector<listOfWeights> MoveGrids::restrict(const vector<listOfWeights>& fine_grid
    return new_coarse_objects;
 }
 
+WeightGrid MoveGrids::restrict(WeightGrid& fine_grid) const
+{
+   // the coarse grid is a view onto the C-points of the fine grid, so nothing is copied
+   return fine_grid.stridedView(m);
+}
+
 void MoveGrids::setCoarseningFactor(unsigned int my_m)
 {
    m = my_m;
@@ -0,0 +1,20 @@
+#include <iomanip>
+
+#include "sequential_comparison.h"
+
+double SequentialComparison::speedup() const
+{
+   return sequential_time / mgrit_time;
+}
+
+void writeComparison(ostream& out, const vector<SequentialComparison>& comparisons)
+{
+   out << setw(8) << "threads" << setw(16) << "MGRIT time (s)" << setw(16) << "serial time (s)" << setw(10) << "speedup" 
+       << setw(14) << "MGRIT phis" << setw(14) << "serial phis" << setw(18) << "final weight diff" << endl;
+   for (const SequentialComparison& comparison : comparisons)
+   {
+      out << setw(8) << comparison.num_threads << setw(16) << comparison.mgrit_time << setw(16) << comparison.sequential_time 
+          << setw(10) << comparison.speedup() << setw(14) << comparison.mgrit_phi_evaluations 
+          << setw(14) << comparison.sequential_phi_evaluations << setw(18) << comparison.weight_difference << endl;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "solver_stats.h"
+
+double LevelStats::totalTime() const
+{
+   return fcf_relax_time + f_relax_time + residual_time + restrict_time + coarse_solve_time + project_time;
+}
+
+double secondsSince(const statsClock::time_point& start)
+{
+   return chrono::duration<double>(statsClock::now() - start).count();
+}
+
+void SolverStats::writeCSV(ostream& out) const
+{
+   out << "level,cycles,fcf_relax_time,f_relax_time,residual_time,restrict_time,coarse_solve_time,project_time,wait_time,phi_evaluations,bytes_allocated" << "\n";
+   for (unsigned int l = 0; l < levels.size(); l++)
+   {
+      const LevelStats& level = levels[l];
+      out << l << "," << level.cycles << "," << level.fcf_relax_time << "," << level.f_relax_time << "," << level.residual_time << "," 
+          << level.restrict_time << "," << level.coarse_solve_time << "," << level.project_time << "," << level.wait_time << "," << level.phi_evaluations << "," 
+          << level.bytes_allocated << "\n";
+   }
+}
+
+void SolverStats::writeJSON(ostream& out) const
+{
+   out << "{\n";
+   out << "  \"iterations\": " << iterations << ",\n";
+   out << "  \"convergence_rate\": " << convergence_rate << ",\n";
+   out << "  \"total_time\": " << total_time << ",\n";
+   out << "  \"residual_norms\": [";
+   for (unsigned int i = 0; i < residual_norms.size(); i++)
+   {
+      out << (i == 0 ? "" : ", ") << residual_norms[i];
+   }
+   out << "],\n";
+   out << "  \"levels\": [";
+   for (unsigned int l = 0; l < levels.size(); l++)
+   {
+      const LevelStats& level = levels[l];
+      out << (l == 0 ? "\n" : ",\n");
+      out << "    {\"level\": " << l << ", \"cycles\": " << level.cycles << ", \"fcf_relax_time\": " << level.fcf_relax_time 
+          << ", \"f_relax_time\": " << level.f_relax_time << ", \"residual_time\": " << level.residual_time 
+          << ", \"restrict_time\": " << level.restrict_time << ", \"coarse_solve_time\": " << level.coarse_solve_time 
+          << ", \"project_time\": " << level.project_time << ", \"wait_time\": " << level.wait_time 
+          << ", \"phi_evaluations\": " << level.phi_evaluations << ", \"bytes_allocated\": " << level.bytes_allocated << "}";
+   }
+   out << (levels.empty() ? "]\n" : "\n  ]\n");
+   out << "}\n";
+}
\ No newline at end of file
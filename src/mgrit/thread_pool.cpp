@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "thread_pool.h"
+
+unsigned int ThreadPool::getNumThreads() const
+{
+   return num_threads;
+}
+
+void ThreadPool::parallelFor(unsigned int begin, unsigned int end, const function<void (unsigned int)>& body)
+{
+
+   // run the loop on the calling thread if there is no one to share the work with
+   if (workers.empty() or end <= begin + 1)
+   {
+      for (unsigned int i = begin; i < end; i++)
+      {
+         body(i);
+      }
+      return;
+   }
+
+   // state shared between the calling thread and the workers for the duration of the loop
+   struct LoopState
+   {
+      atomic<unsigned int> next;
+      atomic<unsigned int> completed;
+      unsigned int end;
+      unsigned int count;
+      exception_ptr error;
+      mutex state_mutex;
+      condition_variable finished;
+   };
+   shared_ptr<LoopState> state = make_shared<LoopState>();
+   state->next = begin;
+   state->completed = 0;
+   state->end = end;
+   state->count = end - begin;
+
+   // each participating thread claims indices until none are left
+   // body is only touched while an index is claimed, so late workers never dereference it after the loop returns
+   const function<void (unsigned int)>* body_ptr = &body;
+   function<void()> work = [state, body_ptr]()
+   {
+      unsigned int i;
+      while ((i = state->next++) < state->end)
+      {
+         try
+         {
+            (*body_ptr)(i);
+         }
+         catch (...)
+         {
+            lock_guard<mutex> lock(state->state_mutex);
+            if (!state->error) {state->error = current_exception();}
+         }
+         if (++state->completed == state->count)
+         {
+            lock_guard<mutex> lock(state->state_mutex);
+            state->finished.notify_all();
+         }
+      }
+   };
+
+   // hand the loop to as many workers as can usefully join in
+   unsigned int num_helpers = min(static_cast<unsigned int>(workers.size()), state->count - 1);
+   {
+      lock_guard<mutex> lock(queue_mutex);
+      for (unsigned int i = 0; i < num_helpers; i++)
+      {
+         tasks.push(work);
+      }
+   }
+   num_helpers == 1 ? queue_condition.notify_one() : queue_condition.notify_all();
+
+   // the calling thread works on the loop as well, so nested calls can never deadlock
+   work();
+
+   unique_lock<mutex> lock(state->state_mutex);
+   state->finished.wait(lock, [&state]() { return state->completed == state->count; });
+   if (state->error) {rethrow_exception(state->error);}
+}
+
+void ThreadPool::parallelForChunks(unsigned int begin, unsigned int end, const function<void (unsigned int, unsigned int)>& body)
+{
+   // the chunks differ in size by at most one index
+   unsigned long count = end > begin ? end - begin : 0;
+   unsigned int num_chunks = min(static_cast<unsigned long>(num_threads), count);
+   parallelFor(0, num_chunks, [begin, count, num_chunks, &body](unsigned int chunk)
+   {
+      body(begin + chunk * count / num_chunks, begin + (chunk + 1) * count / num_chunks);
+   });
+}
+
+ThreadPool::ThreadPool(unsigned int my_num_threads) : num_threads{max(my_num_threads, 1u)}
+{
+   for (unsigned int i = 1; i < num_threads; i++)
+   {
+      workers.emplace_back(&ThreadPool::workerLoop, this);
+   }
+}
+
+ThreadPool::~ThreadPool()
+{
+   {
+      lock_guard<mutex> lock(queue_mutex);
+      stop = true;
+   }
+   queue_condition.notify_all();
+   for (thread& worker : workers)
+   {
+      worker.join();
+   }
+}
+
+void ThreadPool::workerLoop()
+{
+   while (true)
+   {
+      function<void()> task;
+      {
+         unique_lock<mutex> lock(queue_mutex);
+         queue_condition.wait(lock, [this]() { return stop or !tasks.empty(); });
+         if (stop and tasks.empty()) {return;}
+         task = move(tasks.front());
+         tasks.pop();
+      }
+      task();
+   }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <algorithm>
+
+#include "time_slabs.h"
+
+unsigned int TimeSlabs::begin(unsigned int slab) const
+{
+   return min(firstInterval(slab) * m, num_points);
+}
+
+unsigned int TimeSlabs::coarseBegin(unsigned int slab) const
+{
+   return begin(slab) / m;
+}
+
+unsigned int TimeSlabs::coarseSize(unsigned int slab) const
+{
+   // the slab starts at a C-point, so its C-points are every m-th point counted from its start
+   return (size(slab) + m - 1) / m;
+}
+
+unsigned int TimeSlabs::end(unsigned int slab) const
+{
+   return begin(slab + 1);
+}
+
+unsigned int TimeSlabs::firstInterval(unsigned int slab) const
+{
+   // spreads the intervals evenly, so the numbers of intervals of two slabs differ by at most one
+   return static_cast<unsigned long>(slab) * numIntervals() / num_slabs;
+}
+
+unsigned int TimeSlabs::getCoarseningFactor() const
+{
+   return m;
+}
+
+unsigned int TimeSlabs::getNumPoints() const
+{
+   return num_points;
+}
+
+unsigned int TimeSlabs::getNumSlabs() const
+{
+   return num_slabs;
+}
+
+unsigned int TimeSlabs::numIntervals() const
+{
+   return (num_points + m - 1) / m;
+}
+
+unsigned int TimeSlabs::size(unsigned int slab) const
+{
+   return end(slab) - begin(slab);
+}
+
+TimeSlabs::TimeSlabs(unsigned int my_num_points, unsigned int my_m, unsigned int my_num_slabs) : m{my_m}, 
+                                                                                                 num_points{my_num_points}, 
+                                                                                                 num_slabs{my_num_slabs}{}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <algorithm>
+
+#include "weight_grid.h"
+
+size_t WeightGrid::allocatedBytes() const
+{
+   // a view owns no storage
+   return storage.size() * sizeof(double);
+}
+
+void WeightGrid::copyFrom(const WeightGrid& other)
+{
+   // a copy is always contiguous, so strided views are gathered one time step at a time
+   layout = other.layout;
+   num_steps = other.num_steps;
+   step_stride = layout ? layout->getStepSize() : 0;
+   storage.resize(num_steps * step_stride);
+   data = storage.data();
+   if (other.step_stride == step_stride)
+   {
+      copy(other.data, other.data + num_steps * step_stride, data);
+   }
+   else
+   {
+      for (unsigned int i = 0; i < num_steps; i++)
+      {
+         step(i) = other.step(i);
+      }
+   }
+}
+
+void StepView::copyTo(weightType& weights) const
+{
+   // reuses the storage of weights when it already has the right shape
+   weights.resize(layout->getNumLayers());
+   for (unsigned int l = 0; l < layout->getNumLayers(); l++)
+   {
+      weights[l] = (*this)[l];
+   }
+}
+
+Map<const MatrixXd> StepView::operator[](unsigned int l) const
+{
+   return Map<const MatrixXd>(data + layout->getOffset(l), layout->getRows(l), layout->getCols(l));
+}
+
+unsigned int StepView::size() const
+{
+   return layout->getNumLayers();
+}
+
+StepView::StepView(const double* my_data, const WeightLayout* my_layout) : data{my_data},
+                                                                           layout{my_layout}{}
+
+void WeightGrid::copyStep(unsigned int i, weightType& weights) const
+{
+   stepView(i).copyTo(weights);
+}
+
+shared_ptr<const WeightLayout> WeightGrid::getLayout() const
+{
+   return layout;
+}
+
+weightType WeightGrid::getStep(unsigned int i) const
+{
+   weightType weights;
+   copyStep(i, weights);
+   return weights;
+}
+
+bool WeightGrid::isView() const
+{
+   return data != storage.data();
+}
+
+Map<MatrixXd> WeightGrid::layer(unsigned int i, unsigned int l)
+{
+   return Map<MatrixXd>(data + i * step_stride + layout->getOffset(l), layout->getRows(l), layout->getCols(l));
+}
+
+Map<const MatrixXd> WeightGrid::layer(unsigned int i, unsigned int l) const
+{
+   return Map<const MatrixXd>(data + i * step_stride + layout->getOffset(l), layout->getRows(l), layout->getCols(l));
+}
+
+WeightGrid& WeightGrid::operator=(const WeightGrid& other)
+{
+   if (this != &other)
+   {
+      copyFrom(other);
+   }
+   return *this;
+}
+
+WeightGrid& WeightGrid::operator=(WeightGrid&& other)
+{
+   layout = move(other.layout);
+   num_steps = other.num_steps;
+   step_stride = other.step_stride;
+   storage = move(other.storage);
+   data = other.data;
+   other.data = nullptr;
+   other.num_steps = 0;
+   return *this;
+}
+
+void WeightGrid::setStep(unsigned int i, const weightType& weights)
+{
+   for (unsigned int l = 0; l < layout->getNumLayers(); l++)
+   {
+      layer(i, l) = weights[l];
+   }
+}
+
+unsigned int WeightGrid::size() const
+{
+   return num_steps;
+}
+
+Map<VectorXd> WeightGrid::step(unsigned int i)
+{
+   return Map<VectorXd>(data + i * step_stride, layout->getStepSize());
+}
+
+Map<const VectorXd> WeightGrid::step(unsigned int i) const
+{
+   return Map<const VectorXd>(data + i * step_stride, layout->getStepSize());
+}
+
+StepView WeightGrid::stepView(unsigned int i) const
+{
+   return StepView(data + i * step_stride, layout.get());
+}
+
+WeightGrid WeightGrid::stridedView(unsigned int stride)
+{
+   WeightGrid view;
+   view.data = data;
+   view.layout = layout;
+   view.num_steps = (num_steps + stride - 1) / stride;
+   view.step_stride = step_stride * stride;
+   return view;
+}
+
+listOfWeights WeightGrid::toList() const
+{
+   listOfWeights weights(num_steps);
+   for (unsigned int i = 0; i < num_steps; i++)
+   {
+      copyStep(i, weights[i]);
+   }
+   return weights;
+}
+
+WeightGrid::WeightGrid(const listOfWeights& weights) : layout{weights.empty() ? nullptr : make_shared<const WeightLayout>(weights[0])},
+                                                       num_steps(weights.size()),
+                                                       step_stride{layout ? layout->getStepSize() : 0}
+{
+   storage.resize(num_steps * step_stride);
+   data = storage.data();
+   for (unsigned int i = 0; i < num_steps; i++)
+   {
+      setStep(i, weights[i]);
+   }
+}
+
+WeightGrid::WeightGrid(unsigned int my_num_steps, shared_ptr<const WeightLayout> my_layout) : layout{my_layout},
+                                                                                              num_steps{my_num_steps},
+                                                                                              step_stride{my_layout->getStepSize()},
+                                                                                              storage(my_num_steps * my_layout->getStepSize(), 0.0)
+{
+   data = storage.data();
+}
+
+WeightGrid::WeightGrid(const WeightGrid& other)
+{
+   copyFrom(other);
+}
+
+WeightGrid::WeightGrid(WeightGrid&& other) : data{other.data},
+                                             layout{move(other.layout)},
+                                             num_steps{other.num_steps},
+                                             step_stride{other.step_stride},
+                                             storage{move(other.storage)}
+{
+   other.data = nullptr;
+   other.num_steps = 0;
+}
+
+Index WeightLayout::getCols(unsigned int layer) const
+{
+   return cols[layer];
+}
+
+unsigned int WeightLayout::getNumLayers() const
+{
+   return rows.size();
+}
+
+Index WeightLayout::getOffset(unsigned int layer) const
+{
+   return offsets[layer];
+}
+
+Index WeightLayout::getRows(unsigned int layer) const
+{
+   return rows[layer];
+}
+
+Index WeightLayout::getStepSize() const
+{
+   return step_size;
+}
+
+bool WeightLayout::operator==(const WeightLayout& other) const
+{
+   return rows == other.rows and cols == other.cols;
+}
+
+WeightLayout::WeightLayout(const weightType& weights)
+{
+   for (const MatrixXd& weight : weights)
+   {
+      rows.push_back(weight.rows());
+      cols.push_back(weight.cols());
+      offsets.push_back(step_size);
+      step_size += weight.size();
+   }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <Eigen/Dense>
+#include <fstream>
+#include <iostream>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+#include "datasets.h"
+#include "distributed_mgrit_solver.h"
+#include "fixed_neural_network.h"
+#include "neural_network.h"
+#include "phi_generator.h"
+#include "problem_config.h"
+#include "training_propagator.h"
+#include "typedefs.h"
+ 
+using namespace Eigen;
+using namespace std;
+
+// trains the nn of the problem with MGRIT on all processes started by mpirun, e.g. mpirun -np 4 ./mgrit_mpi_problem,
+// where each process only holds its own slab of the time steps and process 0 prints the results
+template <typename Network>
+void solveProblem(const ProblemConfig& config, const MatrixXd& input, const MatrixXd& target)
+{
+
+  // initialize the weights and the right hand side of the linear equation that MGRIT solves
+  // every process draws the same sequence of random numbers, so they all start from the same initial weights
+  weightType random_weights = randomWeights(config.layers);
+  weightType zero_weights = random_weights;
+  for (MatrixXd& weight : zero_weights) {weight.setZero();}
+
+  // construct the propagators used in the MGRIT algorithm, on as many levels as it takes to reach max_coarse_size if set
+  unsigned int max_level = config.max_coarse_size > 0 ? maxLevelForCoarseSize(config.N+1, config.m, config.max_coarse_size) : config.max_level;
+  vector<TrainingPropagator<Network>> phis = generatePropagators<Network>(input, target, config.alpha_b, config.alpha_max, max_level, config.batch_size);
+  const double tol = pow(10, -9) * sqrt(config.N+1);
+  BasicDistributedMGRITSolver<TrainingPropagator<Network>> solver(config.m, phis, max_level, config.display_output, config.num_threads);
+  solver.setPipelineCoarseSolve(config.pipeline_coarse_solve);
+
+  // build the slab of this process and run the solver on it
+  TimeSlabs slabs = solver.getSlabs(config.N+1);
+  unsigned int rank = solver.getRank();
+  listOfWeights slab_weights(slabs.size(rank), zero_weights);
+  if (rank == 0 and !slab_weights.empty()) {slab_weights[0] = random_weights;}
+  WeightGrid w0(slab_weights);
+  WeightGrid rhs(slab_weights);
+  solver.run(w0, rhs, config.N+1, tol, config.f_cycles);
+
+  // write the stats of process 0 for later analysis
+  if (rank == 0 and !config.stats_file.empty())
+  {
+    ofstream stats_file(config.stats_file);
+    bool json = config.stats_file.size() >= 5 and config.stats_file.compare(config.stats_file.size() - 5, 5, ".json") == 0;
+    json ? solver.getStats().writeJSON(stats_file) : solver.getStats().writeCSV(stats_file);
+  }
+
+  // the last process holds the final weights
+  if (config.print_weights and rank == solver.getNumRanks() - 1)
+  {
+    cout << "The MGRIT trained weights are : " << endl;
+    for (MatrixXd weight : w0.getStep(w0.size()-1))
+    {
+      cout << weight << endl;
+    }
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+
+  MPI_Init(&argc, &argv);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // read the parameters of the problem from the command line and the config file
+  ProblemConfig config;
+  try
+  {
+    config = parseArguments(argc, argv);
+  }
+  catch (const invalid_argument& error)
+  {
+    if (rank == 0) {cerr << error.what() << endl << usage(argv[0]);}
+    MPI_Finalize();
+    return 1;
+  }
+
+  // load the training data of the nn
+  vector<MatrixXd> data;
+  try
+  {
+    data = loadDataset(config.dataset, config.layers);
+  }
+  catch (const exception& error)
+  {
+    if (rank == 0) {cerr << error.what() << endl;}
+    MPI_Finalize();
+    return 1;
+  }
+
+  // instantiate the solver on the fixed-size nn for the shapes of the three and four layer problems
+  // the solver throws when there are more processes than F-intervals to split between them
+  try
+  {
+    if (config.layers == vector<Index>{3, 4, 1})
+    {
+      solveProblem<FixedNeuralNetwork<3, 4, 1>>(config, data[0], data[1]);
+    }
+    else if (config.layers == vector<Index>{24, 128, 64, 12})
+    {
+      solveProblem<FixedNeuralNetwork<24, 128, 64, 12>>(config, data[0], data[1]);
+    }
+    else
+    {
+      solveProblem<NeuralNetwork>(config, data[0], data[1]);
+    }
+  }
+  catch (const invalid_argument& error)
+  {
+    if (rank == 0) {cerr << error.what() << endl;}
+    MPI_Finalize();
+    return 1;
+  }
+
+  MPI_Finalize();
+
+}
\ No newline at end of file
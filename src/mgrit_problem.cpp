@@ -0,0 +1,124 @@
+#include <Eigen/Dense>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "datasets.h"
+#include "fixed_neural_network.h"
+#include "mgrit_solver.h"
+#include "neural_network.h"
+#include "phi_generator.h"
+#include "problem_config.h"
+#include "sequential_comparison.h"
+#include "training_propagator.h"
+#include "typedefs.h"
+ 
+using namespace Eigen;
+using namespace std;
+
+// trains the nn of the problem with MGRIT, where the solver applies the propagator of Network without type erasure
+template <typename Network>
+void solveProblem(const ProblemConfig& config, const MatrixXd& input, const MatrixXd& target)
+{
+
+  // initialize the weights and the right hand side of the linear equation that MGRIT solves
+  weightType random_weights = randomWeights(config.layers);
+  weightType zero_weights = random_weights;
+  for (MatrixXd& weight : zero_weights) {weight.setZero();}
+  listOfWeights initial_weights(config.N+1, zero_weights);
+  initial_weights[0] = random_weights;
+  listOfWeights rhs = initial_weights;
+
+  // construct the propagators used in the MGRIT algorithm, on as many levels as it takes to reach max_coarse_size if set
+  unsigned int max_level = config.max_coarse_size > 0 ? maxLevelForCoarseSize(config.N+1, config.m, config.max_coarse_size) : config.max_level;
+  vector<TrainingPropagator<Network>> phis = generatePropagators<Network>(input, target, config.alpha_b, config.alpha_max, max_level, config.batch_size);
+
+  // construct the MGRIT solver and run it
+  const double tol = pow(10, -9) * sqrt(config.N+1);
+  BasicMGRITSolver<TrainingPropagator<Network>> solver(config.m, phis, max_level, config.display_output, config.num_threads);
+  solver.setPipelineCoarseSolve(config.pipeline_coarse_solve);
+  listOfWeights MGRIT_weights = solver.run(initial_weights, rhs, tol, config.f_cycles);
+
+  // write the stats of the run for later analysis
+  if (!config.stats_file.empty())
+  {
+    ofstream stats_file(config.stats_file);
+    bool json = config.stats_file.size() >= 5 and config.stats_file.compare(config.stats_file.size() - 5, 5, ".json") == 0;
+    json ? solver.getStats().writeJSON(stats_file) : solver.getStats().writeCSV(stats_file);
+  }
+
+  if (config.print_weights)
+  {
+    cout << "The MGRIT trained weights are : " << endl;
+    for (MatrixXd weight : MGRIT_weights[MGRIT_weights.size()-1])
+    {
+      cout << weight << endl;
+    }
+
+    // train the neural network in a sequential fashion to get the expected set of final weights
+    weightType weights = initial_weights[0];
+    for (unsigned int i = 0; i < config.N; i++)
+    {
+      unsigned int batch = i % numMiniBatches(input, config.batch_size);
+      weights = Network::propagate(weights, miniBatch(input, batch, config.batch_size), miniBatch(target, batch, config.batch_size), config.alpha_b);
+    }
+
+    cout << "The actual values of the trained weights are: " << endl;
+    for (MatrixXd weight : weights)
+    {
+      cout << weight << endl;
+    }
+  }
+
+  // compare the wall time of MGRIT against sequential training on each number of threads
+  if (!config.comparison_threads.empty())
+  {
+    cout << "Comparison of MGRIT against sequential training: " << endl;
+    writeComparison(cout, compareToSequential(solver, WeightGrid(initial_weights), WeightGrid(rhs), tol, config.f_cycles, config.comparison_threads));
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+
+  // read the parameters of the problem from the command line and the config file
+  ProblemConfig config;
+  try
+  {
+    config = parseArguments(argc, argv);
+  }
+  catch (const invalid_argument& error)
+  {
+    cerr << error.what() << endl << usage(argv[0]);
+    return 1;
+  }
+
+  // load the training data of the nn
+  vector<MatrixXd> data;
+  try
+  {
+    data = loadDataset(config.dataset, config.layers);
+  }
+  catch (const exception& error)
+  {
+    cerr << error.what() << endl;
+    return 1;
+  }
+
+  // instantiate the solver on the fixed-size nn for the shapes of the three and four layer problems
+  if (config.layers == vector<Index>{3, 4, 1})
+  {
+    solveProblem<FixedNeuralNetwork<3, 4, 1>>(config, data[0], data[1]);
+  }
+  else if (config.layers == vector<Index>{24, 128, 64, 12})
+  {
+    solveProblem<FixedNeuralNetwork<24, 128, 64, 12>>(config, data[0], data[1]);
+  }
+  else
+  {
+    solveProblem<NeuralNetwork>(config, data[0], data[1]);
+  }
+
+}
\ No newline at end of file
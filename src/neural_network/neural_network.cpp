@@ -12,6 +12,24 @@ weightType NeuralNetwork::getWeights() const
 
 NeuralNetwork::NeuralNetwork(float my_alpha, weightType my_weights) : alpha{my_alpha}, weights{my_weights}{}
 
+weightType NeuralNetwork::propagate(weightType weights, const MatrixXd& input, const MatrixXd& target, const float& alpha)
+{
+   propagateInPlace(weights, input, target, alpha);
+   return weights;
+}
+
+void NeuralNetwork::propagate(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha, NetworkWorkspace& workspace)
+{
+   trainWeights(weights, input, target, alpha, workspace);
+}
+
+void NeuralNetwork::propagateInPlace(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha)
+{
+   // every thread keeps its own workspace, so concurrent calls share no state
+   static thread_local NetworkWorkspace thread_workspace;
+   trainWeights(weights, input, target, alpha, thread_workspace);
+}
+
 void NeuralNetwork::setAlpha(float my_alpha)
 {
    alpha = my_alpha;
@@ -22,40 +40,56 @@ void NeuralNetwork::setWeights(weightType my_weights)
    weights = my_weights;
 }
 
-MatrixXd NeuralNetwork::sigmoid(const MatrixXd& x, const bool& derivative) const
+void NeuralNetwork::sigmoid(MatrixXd& x)
 {
-   if (derivative)
-   {
-      return x.array() * (1.0 - x.array());
-   }
-   else
-   {
-      return 1.0 / (1.0 + (-1.0 * x).array().exp());
-   }
+   x = 1.0 / (1.0 + (-1.0 * x).array().exp());
 }
 
 void NeuralNetwork::train(const MatrixXd& input, const MatrixXd& target)
 {
-   stack<MatrixXd> node_values;  // initialize a stack to hold the node values to use for backpropogation
+   trainWeights(weights, input, target, alpha, workspace);
+}
+
+void NeuralNetwork::trainWeights(weightType& weights, const MatrixXd& input, const MatrixXd& target, const float& alpha, NetworkWorkspace& workspace)
+{
+   workspace.resize(weights, input.rows());
+   vector<MatrixXd>& node_values = workspace.node_values;
+   vector<MatrixXd>& errors = workspace.errors;
+   vector<MatrixXd>& deltas = workspace.deltas;
+   vector<MatrixXd>& updates = workspace.updates;
+   const unsigned int num_layers = weights.size();
 
    // feed forward through the network
-   MatrixXd result = input;
-   node_values.push(input);
-   for (MatrixXd weight : weights)
+   for (unsigned int l = 0; l < num_layers; l++)
    {
-      result = sigmoid(result * weight, false);
-      node_values.push(result);
+      node_values[l].noalias() = (l == 0 ? input : node_values[l-1]) * weights[l];
+      sigmoid(node_values[l]);
    }
 
    // backpropoage the error through the network
-   MatrixXd error = target - result;
-   for (auto it = weights.rbegin(); it != weights.rend(); ++it)
+   errors[num_layers-1] = target - node_values[num_layers-1];
+   for (unsigned int l = num_layers; l-- > 0;)
+   {
+      const MatrixXd& first_layer_node_values = l == 0 ? input : node_values[l-1];
+      deltas[l] = errors[l].array() * (node_values[l].array() * (1.0 - node_values[l].array()));
+      if (l > 0) {errors[l-1].noalias() = deltas[l] * weights[l].transpose();}
+      updates[l].noalias() = alpha * first_layer_node_values.transpose() * deltas[l];
+      weights[l] += updates[l];
+   }
+}
+
+void NetworkWorkspace::resize(const weightType& weights, const Index& batch_size)
+{
+   // resizing a matrix to the shape it already has does not allocate
+   deltas.resize(weights.size());
+   errors.resize(weights.size());
+   node_values.resize(weights.size());
+   updates.resize(weights.size());
+   for (unsigned int l = 0; l < weights.size(); l++)
    {
-      MatrixXd end_layer_node_values = node_values.top();
-      node_values.pop();
-      MatrixXd first_layer_node_values = node_values.top();
-      MatrixXd delta = error.array() * sigmoid(end_layer_node_values, true).array();
-      error = delta * (*it).transpose();
-      *it = *it + alpha * first_layer_node_values.transpose() * delta;
+      deltas[l].resize(batch_size, weights[l].cols());
+      errors[l].resize(batch_size, weights[l].cols());
+      node_values[l].resize(batch_size, weights[l].cols());
+      updates[l].resize(weights[l].rows(), weights[l].cols());
    }
 }
\ No newline at end of file
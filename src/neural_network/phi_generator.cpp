@@ -0,0 +1,55 @@
+#include "phi_generator.h"
+
+vector<vector<phiFuncType>> generatePhis(const MatrixXd& input, const MatrixXd& target, const float& base_alpha, const float& max_alpha, const unsigned int& max_level, const unsigned int& batch_size, propagatorType propagator)
+{
+
+   vector<vector<phiFuncType>> phis;
+   unsigned int num_batches = numMiniBatches(input, batch_size);
+   
+   // loop through the grids
+   for (unsigned int i = 0; i < max_level; i++)
+   {
+      vector<phiFuncType> row_phis;
+
+      // set the alpha level
+      float alpha = levelAlpha(base_alpha, max_alpha, i);
+
+      // loop through the individual phi values for each grid
+      for (unsigned int j = 0; j < num_batches; j++)
+      {
+         // set the training input and target for the nn
+         MatrixXd batch_input = miniBatch(input, j, batch_size);
+         MatrixXd batch_target = miniBatch(target, j, batch_size);
+
+         // the phis share no state, so they can be applied from several threads at once
+         row_phis.push_back( [batch_input, batch_target, alpha, propagator](const weightType &weights)
+                             {
+                               return propagator(weights, batch_input, batch_target, alpha);
+                             }
+                           );
+      }
+      
+      phis.push_back(row_phis);
+   }
+
+   return phis;
+}
+
+float levelAlpha(const float& base_alpha, const float& max_alpha, const unsigned int& level)
+{
+   // the learning rate doubles on each coarser level up to max_alpha
+   float alpha = base_alpha * pow(2,level);
+   if (alpha > max_alpha) {alpha = max_alpha;};
+   return alpha;
+}
+
+MatrixXd miniBatch(const MatrixXd& data, const unsigned int& batch, const unsigned int& batch_size)
+{
+   Index first_row = static_cast<Index>(batch) * batch_size;
+   return data.middleRows(first_row, min(static_cast<Index>(batch_size), data.rows() - first_row));
+}
+
+unsigned int numMiniBatches(const MatrixXd& data, const unsigned int& batch_size)
+{
+   return (data.rows() + batch_size - 1) / batch_size;
+}
\ No newline at end of file
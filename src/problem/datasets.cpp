@@ -0,0 +1,115 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "datasets.h"
+
+vector<MatrixXd> binaryAdditionData(const unsigned int& bits, const unsigned int& num_rows, const unsigned int& seed)
+{
+
+   srand(seed);            // seed the random number generator to get the same data each time
+   unsigned int max_num = pow(2, bits);    // maximum number that can be stored given the bit size
+   
+   MatrixXd input(num_rows, bits * 2);
+   MatrixXd target(num_rows, bits);
+
+   for (unsigned int i = 0; i < num_rows; i++)
+   {
+      // generate two random numbers and calculate the binary sum
+      unsigned int number_1 = rand() % max_num;
+      unsigned int number_2 = rand() % max_num;
+      unsigned int total = (number_1 + number_2) % max_num;
+
+      // convert the numbers and their sum to binary and store the result
+      for (unsigned int j = 0; j < bits; j++)
+      {
+         input(i,bits-j-1) = (number_1 >> j) & 1;
+      }
+      for (unsigned int j = 0; j < bits; j++)
+      {
+         input(i,2*bits-j-1) = (number_2 >> j) & 1;
+      }
+      for (unsigned int j = 0; j < bits; j++)
+      {
+         target(i,bits-j-1) = (total >> j) & 1;
+      }
+   }
+
+   return {input, target};
+}
+
+vector<MatrixXd> loadDataset(const string& dataset, const vector<Index>& layers)
+{
+   vector<MatrixXd> data;
+   if (dataset == "xor") {data = xorData();}
+   else if (dataset == "binary_addition") {data = binaryAdditionData(layers.back());}
+   else {data = readCSVData(dataset, layers.front());}
+
+   if (data[0].cols() != layers.front() or data[1].cols() != layers.back())
+   {
+      throw invalid_argument("The dataset " + dataset + " does not match the number of nodes in the first and last layer");
+   }
+   return data;
+}
+
+weightType randomWeights(const vector<Index>& layers)
+{
+   weightType weights;
+   for (unsigned int l = 0; l + 1 < layers.size(); l++)
+   {
+      weights.push_back(MatrixXd::Random(layers[l], layers[l+1]));
+   }
+   return weights;
+}
+
+vector<MatrixXd> readCSVData(const string& path, const Index& num_inputs)
+{
+   ifstream file(path);
+   if (!file) {throw invalid_argument("Cannot open the dataset " + path);}
+
+   // read every row first, since the number of rows is not known in advance
+   vector<vector<double>> rows;
+   string line;
+   while (getline(file, line))
+   {
+      if (line.find_first_not_of(" \t\r") == string::npos) {continue;}
+      vector<double> row;
+      stringstream stream(line);
+      string entry;
+      while (getline(stream, entry, ','))
+      {
+         row.push_back(stod(entry));
+      }
+      if (!rows.empty() and row.size() != rows[0].size()) {throw invalid_argument("The rows of the dataset " + path + " differ in length");}
+      rows.push_back(row);
+   }
+   if (rows.empty() or static_cast<Index>(rows[0].size()) <= num_inputs) {throw invalid_argument("The dataset " + path + " has no targets");}
+
+   MatrixXd input(rows.size(), num_inputs);
+   MatrixXd target(rows.size(), rows[0].size() - num_inputs);
+   for (unsigned int i = 0; i < rows.size(); i++)
+   {
+      input.row(i) = Map<const RowVectorXd>(rows[i].data(), num_inputs);
+      target.row(i) = Map<const RowVectorXd>(rows[i].data() + num_inputs, target.cols());
+   }
+   return {input, target};
+}
+
+vector<MatrixXd> xorData()
+{
+   MatrixXd input(4, 3);
+   input << 0.0, 0.0, 1.0,
+            0.0, 1.0, 1.0,
+            1.0, 0.0, 1.0,
+            1.0, 1.0, 1.0;
+
+   MatrixXd target(4, 1);
+   target << 0.0,
+             1.0,
+             1.0,
+             0.0;
+
+   return {input, target};
+}
\ No newline at end of file
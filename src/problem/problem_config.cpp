@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "problem_config.h"
+
+namespace {
+
+   // splits key=value at the first equals sign and strips the surrounding whitespace
+   pair<string, string> splitSetting(const string& setting)
+   {
+      const string whitespace = " \t\r";
+      size_t equals = setting.find('=');
+      string key = setting.substr(0, equals);
+      string value = equals == string::npos ? "" : setting.substr(equals + 1);
+      key.erase(0, key.find_first_not_of(whitespace));
+      key.erase(key.find_last_not_of(whitespace) + 1);
+      value.erase(0, value.find_first_not_of(whitespace));
+      value.erase(value.find_last_not_of(whitespace) + 1);
+      return {key, value};
+   }
+
+   bool toBool(const string& key, const string& value)
+   {
+      if (value == "true" or value == "1") {return true;}
+      if (value == "false" or value == "0") {return false;}
+      throw invalid_argument("The setting " + key + " must be true or false, not " + value);
+   }
+
+   float toFloat(const string& key, const string& value)
+   {
+      size_t end = 0;
+      float result = 0;
+      try {result = stof(value, &end);} catch (const logic_error&) {end = 0;}
+      if (value.empty() or end != value.size()) {throw invalid_argument("The setting " + key + " must be a number, not " + value);}
+      return result;
+   }
+
+   unsigned int toUnsigned(const string& key, const string& value)
+   {
+      size_t end = 0;
+      unsigned long result = 0;
+      try {result = stoul(value, &end);} catch (const logic_error&) {end = 0;}
+      if (value.empty() or value[0] == '-' or end != value.size()) {throw invalid_argument("The setting " + key + " must be a non-negative integer, not " + value);}
+      if (result > numeric_limits<unsigned int>::max()) {throw invalid_argument("The setting " + key + " = " + value + " is out of range");}
+      return result;
+   }
+
+   vector<unsigned int> toUnsignedList(const string& key, const string& value)
+   {
+      vector<unsigned int> result;
+      stringstream stream(value);
+      string entry;
+      while (getline(stream, entry, ','))
+      {
+         result.push_back(toUnsigned(key, splitSetting(entry).first));
+      }
+      return result;
+   }
+
+}
+
+void applySetting(ProblemConfig& config, const string& key, const string& value)
+{
+   if (key == "N") {config.N = toUnsigned(key, value);}
+   else if (key == "m") {config.m = toUnsigned(key, value);}
+   else if (key == "max_level") {config.max_level = toUnsigned(key, value);}
+   else if (key == "max_coarse_size") {config.max_coarse_size = toUnsigned(key, value);}
+   else if (key == "alpha_b") {config.alpha_b = toFloat(key, value);}
+   else if (key == "alpha_max") {config.alpha_max = toFloat(key, value);}
+   else if (key == "batch_size") {config.batch_size = toUnsigned(key, value);}
+   else if (key == "f_cycles") {config.f_cycles = toBool(key, value);}
+   else if (key == "display_output") {config.display_output = toBool(key, value);}
+   else if (key == "num_threads") {config.num_threads = toUnsigned(key, value);}
+   else if (key == "pipeline_coarse_solve") {config.pipeline_coarse_solve = toBool(key, value);}
+   else if (key == "comparison_threads") {config.comparison_threads = toUnsignedList(key, value);}
+   else if (key == "layers") 
+   {
+      vector<unsigned int> layers = toUnsignedList(key, value);
+      config.layers.assign(layers.begin(), layers.end());
+   }
+   else if (key == "dataset") {config.dataset = value;}
+   else if (key == "print_weights") {config.print_weights = toBool(key, value);}
+   else if (key == "stats_file") {config.stats_file = value;}
+   else {throw invalid_argument("Unknown setting " + key);}
+
+   // catch the settings MGRIT cannot run with here rather than deep inside the solver
+   bool zero_comparison_threads = find(config.comparison_threads.begin(), config.comparison_threads.end(), 0u) != config.comparison_threads.end();
+   if (config.m < 2 or config.max_level < 2 or config.batch_size < 1 or config.num_threads < 1 or zero_comparison_threads or config.layers.size() < 2)
+   {
+      throw invalid_argument("The setting " + key + " = " + value + " is out of range");
+   }
+}
+
+ProblemConfig parseArguments(int argc, char* argv[])
+{
+   vector<pair<string, string>> settings;
+   for (int i = 1; i < argc; i++)
+   {
+      string argument = argv[i];
+      if (argument.compare(0, 2, "--") != 0) {throw invalid_argument("Expected a setting of the form --key=value, not " + argument);}
+
+      // accept both --key=value and --key value
+      argument.erase(0, 2);
+      if (argument.find('=') == string::npos)
+      {
+         if (i + 1 >= argc) {throw invalid_argument("The setting " + argument + " has no value");}
+         argument += "=" + string(argv[++i]);
+      }
+      settings.push_back(splitSetting(argument));
+   }
+
+   // the preset and the config file come first, so that the remaining settings override them
+   ProblemConfig config;
+   for (const pair<string, string>& setting : settings)
+   {
+      if (setting.first == "problem") {config = problemPreset(setting.second);}
+   }
+   for (const pair<string, string>& setting : settings)
+   {
+      if (setting.first == "config") {readConfigFile(config, setting.second);}
+   }
+   for (const pair<string, string>& setting : settings)
+   {
+      if (setting.first != "problem" and setting.first != "config") {applySetting(config, setting.first, setting.second);}
+   }
+   return config;
+}
+
+ProblemConfig problemPreset(const string& problem)
+{
+   ProblemConfig config;
+   // the defaults are the three layer problem
+   if (problem == "three_layer")
+   {
+      return config;
+   }
+   else if (problem == "four_layer")
+   {
+      config.alpha_b = 0.025;
+      config.alpha_max = 0.2;
+      config.layers = {24, 128, 64, 12};
+      config.dataset = "binary_addition";
+      config.print_weights = false;
+   }
+   else
+   {
+      throw invalid_argument("Unknown problem " + problem + ", expected three_layer or four_layer");
+   }
+   return config;
+}
+
+void readConfigFile(ProblemConfig& config, const string& path)
+{
+   ifstream file(path);
+   if (!file) {throw invalid_argument("Cannot open the config file " + path);}
+
+   // one key = value pair per line, where everything after a # is a comment
+   string line;
+   while (getline(file, line))
+   {
+      line = line.substr(0, line.find('#'));
+      if (line.find_first_not_of(" \t\r") == string::npos) {continue;}
+      pair<string, string> setting = splitSetting(line);
+      if (setting.first == "problem") {config = problemPreset(setting.second);}
+      else {applySetting(config, setting.first, setting.second);}
+   }
+}
+
+string usage(const string& program)
+{
+   return "Usage: " + program + " [--problem=three_layer|four_layer] [--config=file] [--key=value ...]\n"
+          "Settings (also accepted as key = value lines in a config file):\n"
+          "  N, m, max_level, max_coarse_size, alpha_b, alpha_max,\n"
+          "  batch_size, num_threads                                         numbers\n"
+          "  f_cycles, display_output, pipeline_coarse_solve, print_weights  true or false\n"
+          "  comparison_threads, layers                                      comma separated lists, e.g. 1,2,4\n"
+          "  dataset                                                         xor, binary_addition or a csv file\n"
+          "  stats_file                                                      file the solver stats are written to\n";
+}
\ No newline at end of file
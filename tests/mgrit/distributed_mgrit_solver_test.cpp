@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+#include "distributed_mgrit_solver.h"
+#include "mgrit_solver.h"
+#include "neural_network.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+// the fine level cycles through three phis, so a slab starting at an even time step only applies the right phis when it
+// counts its time steps on the whole grid
+class DistributedMGRITSolverTest : public testing::Test {
+
+ protected:
+
+  const unsigned int m = 2;
+  const unsigned int input_size = 100;
+
+  listOfWeights input{input_size + 1, {MatrixXd::Zero(3,4), MatrixXd::Zero(4,1)}};
+
+  Matrix<double, 4, 3> nn_input;
+  Matrix<double, 4, 1> target;
+
+  vector<phiFuncType> phis(const double& alpha)
+  {
+    vector<phiFuncType> level_phis;
+    for (double scale : {1.0, 0.5, 0.25})
+    {
+      level_phis.push_back([this, alpha, scale](const weightType &weights) {return NeuralNetwork::propagate(weights, nn_input, target, alpha * scale);});
+    }
+    return level_phis;
+  }
+
+  vector<vector<phiFuncType>> levelPhis(const unsigned int& max_level)
+  {
+    vector<vector<phiFuncType>> level_phis;
+    for (unsigned int level = 0; level < max_level; level++)
+    {
+      level_phis.push_back(phis(pow(m, level)));
+    }
+    return level_phis;
+  }
+
+  // setup test input to be used
+  void SetUp() override
+  {
+
+    // every process must start from the same weights, so they are not drawn at random
+    input[0] = {MatrixXd::Constant(3, 4, 0.25), MatrixXd::Constant(4, 1, -0.5)};
+    input[0][0](1, 2) = -0.75;
+    input[0][1](3, 0) = 1.0;
+
+    // initialize the data for the neural network
+    nn_input << 0.0, 0.0, 1.0,
+                0.0, 1.0, 1.0,
+                1.0, 0.0, 1.0,
+                1.0, 1.0, 1.0;
+
+    target << 0.0,
+              1.0,
+              1.0,
+              0.0;
+
+  }
+
+  // the distributed solver runs the same cycles as the serial one, so it gives exactly the same weights
+  // whether the messages overlap the relaxation only changes the order in which the intervals are relaxed
+  void testRun(const unsigned int& max_level, const bool& f_cycle, const unsigned int& num_threads = 1, const bool& overlap = true)
+  {
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    MGRITSolver serial_solver(m, levelPhis(max_level), max_level);
+    DistributedMGRITSolver solver(m, levelPhis(max_level), max_level, false, num_threads);
+    solver.setOverlap(overlap);
+    listOfWeights expected_output = serial_solver.run(input, input, tol, f_cycle);
+    listOfWeights actual_output = solver.run(input, input, tol, f_cycle);
+    testListOfVectors(actual_output, expected_output);
+
+    SolverStats expected_stats = serial_solver.getStats();
+    SolverStats actual_stats = solver.getStats();
+    ASSERT_EQ(actual_stats.iterations, expected_stats.iterations);
+    ASSERT_EQ(actual_stats.residual_norms.size(), expected_stats.residual_norms.size());
+    for (unsigned int i = 0; i < expected_stats.residual_norms.size(); i++)
+    {
+      ASSERT_NEAR(actual_stats.residual_norms[i], expected_stats.residual_norms[i], 1e-12 * expected_stats.residual_norms[0]);
+    }
+  }
+
+};
+
+TEST_F(DistributedMGRITSolverTest, Getters){
+
+    DistributedMGRITSolver solver(m, levelPhis(3), 3, true, 2);
+    int rank;
+    int num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    ASSERT_EQ(solver.getCoarseningFactor(), m);
+    ASSERT_TRUE(solver.getDisplayStats());
+    ASSERT_EQ(solver.getMaxLevel(), 3);
+    ASSERT_EQ(solver.getNumRanks(), num_ranks);
+    ASSERT_EQ(solver.getNumThreads(), 2);
+    ASSERT_TRUE(solver.getOverlap());
+    ASSERT_TRUE(solver.getPipelineCoarseSolve());
+    ASSERT_EQ(solver.getRank(), rank);
+    ASSERT_EQ(solver.getSlabs(input_size + 1).getNumSlabs(), num_ranks);
+    solver.setDisplayStats(false);
+    ASSERT_FALSE(solver.getDisplayStats());
+    solver.setOverlap(false);
+    ASSERT_FALSE(solver.getOverlap());
+    solver.setPipelineCoarseSolve(false);
+    ASSERT_FALSE(solver.getPipelineCoarseSolve());
+
+}
+
+TEST_F(DistributedMGRITSolverTest, VIteration1Level){
+
+    // a single level runs like 2 levels, so it gives the weights of the serial solver on 2 levels
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    MGRITSolver serial_solver(m, levelPhis(2), 2);
+    DistributedMGRITSolver solver(m, levelPhis(2), 1);
+    testListOfVectors(solver.run(input, input, tol, false), serial_solver.run(input, input, tol, false));
+    ASSERT_EQ(solver.getStats().levels.size(), 2u) << "The stats do not cover the level of the coarse solve";
+
+}
+
+TEST_F(DistributedMGRITSolverTest, VIteration2Levels){
+
+    testRun(2, false);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, VIteration4Levels){
+
+    testRun(4, false);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, FIteration2Levels){
+
+    testRun(2, true);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, FIteration4LevelsParallel){
+
+    testRun(4, true, 2);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, FIteration4LevelsWithoutOverlap){
+
+    testRun(4, true, 1, false);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, VIterationShortSlabs){
+
+    // with 7 time points and m = 2 most slabs hold a single interval, whose C-point and last time step both depend on
+    // the slab on the left
+    listOfWeights short_input(input.begin(), input.begin() + 7);
+    double tol = 1e-9;
+    MGRITSolver serial_solver(m, levelPhis(2), 2);
+    DistributedMGRITSolver solver(m, levelPhis(2), 2);
+    testListOfVectors(solver.run(short_input, short_input, tol, false), serial_solver.run(short_input, short_input, tol, false));
+
+}
+
+TEST_F(DistributedMGRITSolverTest, RunSlab){
+
+    // each process only passes its own slab and gets back its part of the solution
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    DistributedMGRITSolver solver(m, levelPhis(3), 3);
+    listOfWeights expected_output = solver.run(input, input, tol, true);
+    TimeSlabs slabs = solver.getSlabs(input.size());
+    unsigned int rank = solver.getRank();
+    listOfWeights slab_input(input.begin() + slabs.begin(rank), input.begin() + slabs.end(rank));
+    WeightGrid w0(slab_input);
+    solver.run(w0, WeightGrid(slab_input), input.size(), tol, true);
+    testListOfVectors(w0.toList(), listOfWeights(expected_output.begin() + slabs.begin(rank), expected_output.begin() + slabs.end(rank)));
+    ASSERT_GT(solver.getStats().levels[0].phi_evaluations, 0u);
+
+}
+
+TEST_F(DistributedMGRITSolverTest, TooManyProcesses){
+
+    // 5 time points form 3 F-intervals, which cannot be split over more than 3 processes
+    DistributedMGRITSolver solver(m, levelPhis(2), 2);
+    listOfWeights short_input(input.begin(), input.begin() + 5);
+    if (solver.getNumRanks() > 3)
+    {
+        ASSERT_THROW(solver.run(short_input, short_input, 1e-9, false), invalid_argument);
+    }
+    else
+    {
+        ASSERT_NO_THROW(solver.run(short_input, short_input, 1e-9, false));
+    }
+
+}
\ No newline at end of file
@@ -27,7 +27,10 @@ class MGRITHelperTest : public testing::Test {
 	return output;
   };
 
+  const unsigned int num_threads = 4;
+
   MGRITHelper helper{{mult_2}};
+  MGRITHelper parallel_helper{{mult_2}, num_threads};
    
   const unsigned int input_size = 50;
   weightType test_weights;
@@ -73,6 +76,18 @@ TEST_F(MGRITHelperTest, AddArrays){
 
 }
 
+TEST_F(MGRITHelperTest, AddArraysGrid){
+
+	listOfWeights array_to_add(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+	listOfWeights expected_output = helper.addOrSubtract(input, array_to_add, plus<MatrixXd>());
+
+	// the grid overload gives the same result when writing into one of its inputs
+	WeightGrid result(input);
+	helper.addOrSubtract(result, WeightGrid(array_to_add), plus<double>(), result);
+	testListOfVectors(result.toList(), expected_output);
+
+}
+
 TEST_F(MGRITHelperTest, EuclideanNorm){
 
 	// construct the expected output
@@ -92,6 +107,14 @@ TEST_F(MGRITHelperTest, EuclideanNorm){
 
 }
 
+TEST_F(MGRITHelperTest, EuclideanNormGrid){
+
+	double expected_norm = helper.euclideanNorm(input);
+	double actual_norm = helper.euclideanNorm(WeightGrid(input));
+	ASSERT_NEAR(actual_norm, expected_norm, 1e-12) << "The actual norm " << actual_norm << " is not equal to the expected norm " << expected_norm;
+
+}
+
 TEST_F(MGRITHelperTest, ForwardSolve){
 
 	// initialize the rhs matrix used to solve the linear system
@@ -112,6 +135,49 @@ TEST_F(MGRITHelperTest, ForwardSolve){
 
 }
 
+TEST_F(MGRITHelperTest, ForwardSolveGrid){
+
+	listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+	listOfWeights expected_output = helper.forwardSolve(rhs);
+
+	// solve into a separate grid and in place
+	WeightGrid rhs_grid(rhs);
+	WeightGrid actual_output(input_size, rhs_grid.getLayout());
+	helper.forwardSolve(rhs_grid, actual_output);
+	testListOfVectors(actual_output.toList(), expected_output);
+	helper.forwardSolve(rhs_grid, rhs_grid);
+	testListOfVectors(rhs_grid.toList(), expected_output);
+
+}
+
+TEST_F(MGRITHelperTest, ForwardSolveSteps){
+
+	// every step is handed to the callback in order and only once it is solved
+	listOfWeights expected_output = helper.forwardSolve(input);
+	WeightGrid rhs_grid(input);
+	WeightGrid actual_output(input_size, rhs_grid.getLayout());
+	vector<unsigned int> solved_steps;
+	helper.forwardSolve(rhs_grid, actual_output, [&](unsigned int i)
+	{
+		solved_steps.push_back(i);
+		WeightGrid solved_step(listOfWeights{expected_output[i]});
+		ASSERT_TRUE(actual_output.step(i) == solved_step.step(0)) << "Step " << i << " was reported before it was solved";
+	});
+	vector<unsigned int> expected_steps(input_size);
+	iota(expected_steps.begin(), expected_steps.end(), 0);
+	testVectors(solved_steps, expected_steps);
+
+}
+
+TEST_F(MGRITHelperTest, GetNumThreads){
+
+    unsigned int helper_threads = helper.getNumThreads();
+    ASSERT_EQ(helper_threads, 1u) << "The number of threads from the helper class " << helper_threads << " is not equal to 1";
+    helper_threads = parallel_helper.getNumThreads();
+    ASSERT_EQ(helper_threads, num_threads) << "The number of threads from the helper class " << helper_threads << " is not equal to " << num_threads;
+
+}
+
 TEST_F(MGRITHelperTest, GetPhi){
 
     // test that the output returned from both functions is the same
@@ -138,6 +204,29 @@ TEST_F(MGRITHelperTest, MatMultiply){
 
 }
 
+TEST_F(MGRITHelperTest, MatMultiplyGrid){
+
+	listOfWeights expected_output = helper.matMultiply(input);
+	WeightGrid input_grid(input);
+	WeightGrid actual_output(input_size, input_grid.getLayout());
+	helper.matMultiply(input_grid, actual_output);
+	testListOfVectors(actual_output.toList(), expected_output);
+
+}
+
+TEST_F(MGRITHelperTest, MatMultiplyParallel){
+
+	// the multithreaded matrix multiplication must be bit-identical to the serial one
+	testListOfVectors(parallel_helper.matMultiply(input), helper.matMultiply(input));
+	WeightGrid input_grid(input);
+	WeightGrid expected_output(input_size, input_grid.getLayout());
+	WeightGrid actual_output(input_size, input_grid.getLayout());
+	helper.matMultiply(input_grid, expected_output);
+	parallel_helper.matMultiply(input_grid, actual_output);
+	testListOfVectors(actual_output.toList(), expected_output.toList());
+
+}
+
 TEST_F(MGRITHelperTest, Residual){
 
 	// initialize the rhs matrix to calculate the residuals of the linear system
@@ -152,6 +241,87 @@ TEST_F(MGRITHelperTest, Residual){
 
 }
 
+TEST_F(MGRITHelperTest, ResidualGrid){
+
+	listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+	listOfWeights expected_output = helper.residual(input, rhs);
+
+	// the residual may be written into the rhs
+	WeightGrid rhs_grid(rhs);
+	helper.residual(WeightGrid(input), rhs_grid, rhs_grid);
+	testListOfVectors(rhs_grid.toList(), expected_output);
+
+}
+
+TEST_F(MGRITHelperTest, ResidualParallel){
+
+	// the multithreaded residual must be bit-identical to the serial one, also when it is written into the rhs
+	listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+	listOfWeights expected_output = helper.residual(input, rhs);
+	testListOfVectors(parallel_helper.residual(input, rhs), expected_output);
+	WeightGrid rhs_grid(rhs);
+	parallel_helper.residual(WeightGrid(input), rhs_grid, rhs_grid);
+	testListOfVectors(rhs_grid.toList(), expected_output);
+
+	// adding the grids on several threads gives the same sum as adding the lists
+	WeightGrid sum(input_size, rhs_grid.getLayout());
+	parallel_helper.addOrSubtract(WeightGrid(input), WeightGrid(rhs), plus<double>(), sum);
+	testListOfVectors(sum.toList(), helper.addOrSubtract(input, rhs, plus<MatrixXd>()));
+
+}
+
+TEST_F(MGRITHelperTest, ResidualNorm){
+
+	listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+
+	// the fused norm agrees with the norm of the full residual
+	double expected_norm = helper.euclideanNorm(helper.residual(input, rhs));
+	double actual_norm = helper.residualNorm(input, rhs);
+	ASSERT_NEAR(actual_norm, expected_norm, 1e-12) << "The residual norm " << actual_norm << " is not equal to the expected norm " << expected_norm;
+	actual_norm = helper.residualNorm(WeightGrid(input), WeightGrid(rhs));
+	ASSERT_NEAR(actual_norm, expected_norm, 1e-12) << "The residual norm of the grid " << actual_norm << " is not equal to the expected norm " << expected_norm;
+
+	// an empty grid has no residual
+	ASSERT_EQ(parallel_helper.residualNorm(listOfWeights(), listOfWeights()), 0.0) << "The residual norm of an empty list is not 0";
+	ASSERT_EQ(parallel_helper.residualNorm(WeightGrid(), WeightGrid()), 0.0) << "The residual norm of an empty grid is not 0";
+
+}
+
+TEST_F(MGRITHelperTest, ResidualNormParallel){
+
+	// the fused norm does not depend on the number of threads it is computed on
+	listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+	ASSERT_EQ(parallel_helper.residualNorm(input, rhs), helper.residualNorm(input, rhs)) << "The parallel residual norm differs from the serial one";
+	WeightGrid input_grid(input);
+	WeightGrid rhs_grid(rhs);
+	ASSERT_EQ(parallel_helper.residualNorm(input_grid, rhs_grid), helper.residualNorm(input_grid, rhs_grid)) << "The parallel residual norm of the grid differs from the serial one";
+
+}
+
+TEST_F(MGRITHelperTest, SharedThreadPool){
+
+    // a helper that shares its pool computes the same residual norm as one with a pool of its own
+    shared_ptr<ThreadPool> pool = make_shared<ThreadPool>(num_threads);
+    MGRITHelper shared_helper({mult_2}, pool);
+    ASSERT_EQ(shared_helper.getNumThreads(), num_threads) << "The helper class does not use the threads of the shared pool";
+    listOfWeights rhs(input_size, {MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+    ASSERT_EQ(shared_helper.residualNorm(input, rhs), helper.residualNorm(input, rhs)) << "The helper with the shared pool gives a different residual norm";
+
+}
+
+TEST_F(MGRITHelperTest, SetNumThreads){
+
+    // ensure the helper class is initialized properly
+    unsigned int helper_threads = helper.getNumThreads();
+    ASSERT_EQ(helper_threads, 1u) << "The number of threads from the helper class " << helper_threads << " is not equal to 1";
+
+    // give the helper class a new number of threads and test to make sure it is set correctly
+    helper.setNumThreads(num_threads);
+    helper_threads = helper.getNumThreads();
+    ASSERT_EQ(helper_threads, num_threads) << "The new number of threads from the helper class " << helper_threads << " is not equal to " << num_threads;
+
+}
+
 TEST_F(MGRITHelperTest, SetPhi){
 
     // ensure the helper class is initialized properly
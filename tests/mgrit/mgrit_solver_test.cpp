@@ -35,6 +35,17 @@ class MGRITSolverTest : public testing::Test {
     return testNN.getWeights();
   };
 
+  // phi1 and phi2 train the shared testNN, so the tests that apply the phis on several threads use these instead
+  const phiFuncType stateless_phi1 = [this](const weightType &weights) 
+  {
+    return NeuralNetwork::propagate(weights, nn_input, target, 1.0);
+  };
+
+  const phiFuncType stateless_phi2 = [this](const weightType &weights) 
+  {
+    return NeuralNetwork::propagate(weights, nn_input, target, 2.0);
+  };
+
   MGRITSolver solver1{m, {{phi1}, {phi2}}, max_level};
   const MGRITHelper helper1{{phi1}};
 
@@ -103,6 +114,59 @@ void testRun(const NeuralNetwork& nn, const MatrixXd& nn_input, const MatrixXd&
 
 }
 
+TEST_F(MGRITSolverTest, CoarseCorrection){
+
+    // on two levels the correction is the forward solve of the coarse system minus the coarse weights
+    listOfWeights w1(10, test_weights);
+    listOfWeights r1(10, {MatrixXd::Constant(3, 4, 0.1), MatrixXd::Constant(4, 1, -0.2)});
+    for (unsigned int i = 1; i < w1.size(); i++)
+    {
+        w1[i] = phi1(w1[i-1]);
+    }
+    const MGRITHelper helper2{{phi2}};
+    listOfWeights rhs1 = helper2.addOrSubtract(helper2.matMultiply(w1), r1, plus<MatrixXd>());
+    listOfWeights expected_output = helper2.addOrSubtract(helper2.forwardSolve(rhs1), w1, minus<MatrixXd>());
+
+    SolverStats stats;
+    stats.levels.resize(max_level);
+    WeightGrid e1;
+    solver1.coarseCorrection(0, WeightGrid(w1), WeightGrid(r1), true, e1, stats);
+    testListOfVectors(e1.toList(), expected_output);
+    ASSERT_EQ(stats.levels[0].phi_evaluations, 0u);
+    ASSERT_EQ(stats.levels[1].phi_evaluations, 2 * (w1.size() - 1));
+
+}
+
+TEST_F(MGRITSolverTest, ConcurrentRuns){
+
+    // several threads run the same solver at once, each from its own initial weights
+    const unsigned int num_runs = 4;
+    solver1.setPhis({{stateless_phi1}, {stateless_phi2}});
+    solver1.setNumThreads(2);
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    vector<listOfWeights> initial_weights(num_runs, input);
+    vector<listOfWeights> expected_output;
+    for (listOfWeights& weights : initial_weights)
+    {
+        weights[0] = {MatrixXd::Random(3,4), MatrixXd::Random(4,1)};
+        expected_output.push_back(solver1.run(weights, weights, tol, true));
+    }
+    vector<listOfWeights> concurrent_output(num_runs);
+    ThreadPool pool(num_runs);
+    pool.parallelFor(0, num_runs, [this, &initial_weights, &concurrent_output, &tol](unsigned int i)
+    {
+        concurrent_output[i] = solver1.run(initial_weights[i], initial_weights[i], tol, true);
+    });
+
+    // the runs share no state, so each gives the same weights as on its own
+    for (unsigned int i = 0; i < num_runs; i++)
+    {
+        testListOfVectors(concurrent_output[i], expected_output[i]);
+    }
+    ASSERT_GT(solver1.getStats().iterations, 0u) << "The solver does not keep the stats of the last run";
+
+}
+
 TEST_F(MGRITSolverTest, GetCoarseningFactor){
     
     unsigned int solver_m = solver1.getCoarseningFactor();
@@ -124,6 +188,13 @@ TEST_F(MGRITSolverTest, GetMaxLevel){
 
 }
 
+TEST_F(MGRITSolverTest, GetNumThreads){
+    
+    unsigned int threads = solver1.getNumThreads();
+    ASSERT_EQ(threads, 1u) << "The number of threads " << threads << " from the MGRITSolver class is not equal to 1";
+
+}
+
 TEST_F(MGRITSolverTest, GetPhis){
 
     // test that the output returned from both functions is the same
@@ -137,6 +208,107 @@ TEST_F(MGRITSolverTest, GetPhis){
 
 }
 
+TEST_F(MGRITSolverTest, GetPipelineCoarseSolve){
+    
+    bool pipeline_coarse_solve = solver1.getPipelineCoarseSolve();
+    ASSERT_TRUE(pipeline_coarse_solve) << "The MGRITSolver class does not pipeline the coarse solve by default";
+
+}
+
+TEST_F(MGRITSolverTest, GetStats){
+
+    // count the phi applications independently of the solver
+    unsigned long num_phi_calls = 0;
+    const phiFuncType counted_phi = [this, &num_phi_calls](const weightType& weights)
+    {
+        num_phi_calls++;
+        return phi1(weights);
+    };
+    const unsigned int max_level = 4;
+    solver1.setMaxLevel(max_level);
+    solver1.setPhis(vector<vector<phiFuncType>>(max_level, {counted_phi}));
+
+    WeightGrid weights(input);
+    SolverStats stats = solver1.run(weights, WeightGrid(input), pow(10, -9) * sqrt(input_size + 1), true);
+
+    // the report holds one norm per iteration plus the initial norm and one entry per level
+    ASSERT_GT(stats.iterations, 0u) << "The solver did not run any iterations";
+    ASSERT_EQ(stats.residual_norms.size(), stats.iterations + 1) << "The report does not hold the initial norm and one norm per iteration";
+    ASSERT_EQ(stats.levels.size(), max_level) << "The report does not hold one entry per level";
+    ASSERT_EQ(stats.levels[0].cycles, stats.iterations) << "The finest level did not run one cycle per iteration";
+
+    // the phi evaluations of all levels add up to the number of phi calls and the coarse solve only runs on the coarsest level
+    unsigned long phi_evaluations = 0;
+    for (unsigned int l = 0; l < max_level; l++)
+    {
+        ASSERT_GT(stats.levels[l].phi_evaluations, 0u) << "No phi was applied on level " << l;
+        ASSERT_GE(stats.levels[l].totalTime(), 0.0) << "Level " << l << " has a negative time";
+        phi_evaluations += stats.levels[l].phi_evaluations;
+        if (l + 1 < max_level) 
+        {
+            ASSERT_GT(stats.levels[l].bytes_allocated, 0u) << "No grids were allocated on level " << l;
+            ASSERT_EQ(stats.levels[l].coarse_solve_time, 0.0) << "A coarse solve was recorded on level " << l;
+        }
+    }
+    ASSERT_EQ(phi_evaluations, num_phi_calls) << "The phi evaluations in the report do not match the number of phi calls";
+    ASSERT_LE(stats.levels[0].totalTime(), stats.total_time) << "The time of the finest level exceeds the time of the run";
+
+    // the stats of the last run stay available from the solver
+    ASSERT_EQ(solver1.getStats().iterations, stats.iterations) << "The solver does not keep the stats of the last run";
+
+}
+
+TEST_F(MGRITSolverTest, MaxLevelForCoarseSize){
+
+    // with m = 2 the 101 time points coarsen to 51, 26, 13, 7, 4, 2 and 1 points
+    ASSERT_EQ(maxLevelForCoarseSize(101, 2, 60), 2u);
+    ASSERT_EQ(maxLevelForCoarseSize(101, 2, 51), 2u);
+    ASSERT_EQ(maxLevelForCoarseSize(101, 2, 50), 3u);
+    ASSERT_EQ(maxLevelForCoarseSize(101, 2, 7), 5u);
+    ASSERT_EQ(maxLevelForCoarseSize(101, 2, 1), 8u);
+    ASSERT_EQ(maxLevelForCoarseSize(101, 4, 7), 3u);
+    ASSERT_THROW(maxLevelForCoarseSize(101, 1, 7), invalid_argument);
+    ASSERT_THROW(maxLevelForCoarseSize(101, 2, 0), invalid_argument);
+
+}
+
+TEST_F(MGRITSolverTest, PipelinedCoarseSolve){
+
+    // on several threads the F-relaxation above the coarsest level starts while the forward solve on the coarsest level
+    // is still running, which applies the same phis to the same weights, so it gives exactly the weights of one thread
+    // and of several threads that relax only after the whole solve
+    for (unsigned int num_points : {input_size, input_size + 1})
+    {
+        listOfWeights points_input(input.begin(), input.begin() + num_points);
+        double tol = pow(10, -9) * sqrt(num_points);
+        for (unsigned int levels : {2u, 3u})
+        {
+            vector<vector<phiFuncType>> phis(levels, {stateless_phi1});
+            for (bool f_cycle : {false, true})
+            {
+                MGRITSolver serial_solver(m, phis, levels);
+                listOfWeights serial_output = serial_solver.run(points_input, points_input, tol, f_cycle);
+                for (bool pipeline_coarse_solve : {true, false})
+                {
+                    MGRITSolver parallel_solver(m, phis, levels, false, 3);
+                    parallel_solver.setPipelineCoarseSolve(pipeline_coarse_solve);
+                    testListOfVectors(parallel_solver.run(points_input, points_input, tol, f_cycle), serial_output);
+                    testVectors(parallel_solver.getStats().residual_norms, serial_solver.getStats().residual_norms);
+                    for (unsigned int l = 0; l < levels; l++)
+                    {
+                        ASSERT_EQ(parallel_solver.getStats().levels[l].phi_evaluations, serial_solver.getStats().levels[l].phi_evaluations);
+                    }
+                }
+
+                // the flag has no effect on one thread, which never pipelines the coarse solve
+                serial_solver.setPipelineCoarseSolve(false);
+                testListOfVectors(serial_solver.run(points_input, points_input, tol, f_cycle), serial_output);
+            }
+        }
+    }
+
+}
+
 TEST_F(MGRITSolverTest, SetCoarseningFactor){
     
     // ensure the class is initialized properly
@@ -151,6 +323,19 @@ TEST_F(MGRITSolverTest, SetCoarseningFactor){
 
 }
 
+TEST_F(MGRITSolverTest, SetCoarseningFactorRun){
+
+    // the levels of the solver are rebuilt for the new coarsening factor, so it solves like a solver built with it
+    unsigned int new_m = 4;
+    MGRITSolver new_solver(new_m, {{stateless_phi1}, {stateless_phi2}}, max_level);
+    solver1.setPhis({{stateless_phi1}, {stateless_phi2}});
+    solver1.setCoarseningFactor(new_m);
+    solver1.setNumThreads(2);
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    testListOfVectors(solver1.run(input, input, tol, false), new_solver.run(input, input, tol, false));
+
+}
+
 TEST_F(MGRITSolverTest, SetDisplayStats){
     
     // ensure the class is initialized properly
@@ -178,6 +363,20 @@ TEST_F(MGRITSolverTest, SetMaxLevel){
 
 }
 
+TEST_F(MGRITSolverTest, SetNumThreads){
+    
+    // ensure the class is initialized properly
+    unsigned int threads = solver1.getNumThreads();
+    ASSERT_EQ(threads, 1u) << "The number of threads " << threads << " from the MGRITSolver class is not equal to 1";
+    
+    // give the class a new number of threads and test to make sure it is set correctly
+    unsigned int new_num_threads = 4;
+    solver1.setNumThreads(new_num_threads);
+    threads = solver1.getNumThreads();
+    ASSERT_EQ(threads, new_num_threads) << "The number of threads " << threads << " from the MGRITSolver class is not equal to the new " << new_num_threads;
+
+}
+
 TEST_F(MGRITSolverTest, SetPhis){
 
   // ensure the MGRITSolver class is initialized properly
@@ -223,6 +422,46 @@ TEST_F(MGRITSolverTest, SetPhis){
 
 }
 
+TEST_F(MGRITSolverTest, SetPipelineCoarseSolve){
+    
+    // ensure the class is initialized properly
+    bool pipeline_coarse_solve = solver1.getPipelineCoarseSolve();
+    ASSERT_TRUE(pipeline_coarse_solve) << "The MGRITSolver class does not pipeline the coarse solve by default";
+    
+    // turn the pipelining off and test to make sure it is set correctly
+    solver1.setPipelineCoarseSolve(false);
+    pipeline_coarse_solve = solver1.getPipelineCoarseSolve();
+    ASSERT_FALSE(pipeline_coarse_solve) << "The MGRITSolver class still pipelines the coarse solve after it was turned off";
+
+}
+
+TEST_F(MGRITSolverTest, SharedThreadPool){
+
+    // a solver handed a pool runs on the threads of that pool instead of starting its own, and solves the same system
+    shared_ptr<ThreadPool> pool = make_shared<ThreadPool>(3);
+    vector<vector<phiFuncType>> phis(3, {stateless_phi1});
+    MGRITSolver serial_solver(m, phis, 3);
+    MGRITSolver shared_solver(m, phis, 3, false, pool);
+    ASSERT_EQ(shared_solver.getNumThreads(), 3u);
+    double tol = pow(10, -9) * sqrt(input_size);
+    for (bool f_cycle : {false, true})
+    {
+        testListOfVectors(shared_solver.run(input, input, tol, f_cycle), serial_solver.run(input, input, tol, f_cycle));
+    }
+    ASSERT_GT(pool.use_count(), 1) << "The solver does not hold the pool it was handed";
+
+}
+
+TEST_F(MGRITSolverTest, VIteration1Level){
+
+	// the coarse solve of a single level goes to the level below it, just like on 2 levels
+	solver1.setMaxLevel(1);
+	testRun(testNN, nn_input, target, solver1, helper1, input, false);
+	solver1.run(input, input, pow(10, -9) * sqrt(input_size + 1), false);
+	ASSERT_EQ(solver1.getStats().levels.size(), 2u) << "The stats do not cover the level of the coarse solve";
+
+}
+
 TEST_F(MGRITSolverTest, VIteration2Levels){
 
 	solver1.setMaxLevel(2);
@@ -240,6 +479,16 @@ TEST_F(MGRITSolverTest, VIteration10Levels){
 
 }
 
+TEST_F(MGRITSolverTest, FIteration1Level){
+
+	// the coarse solve of a single level goes to the level below it, just like on 2 levels
+	solver1.setMaxLevel(1);
+	testRun(testNN, nn_input, target, solver1, helper1, input, true);
+	solver1.run(input, input, pow(10, -9) * sqrt(input_size + 1), true);
+	ASSERT_EQ(solver1.getStats().levels.size(), 2u) << "The stats do not cover the level of the coarse solve";
+
+}
+
 TEST_F(MGRITSolverTest, FIteration2Levels){
 
 	solver1.setMaxLevel(2);
@@ -255,4 +504,15 @@ TEST_F(MGRITSolverTest, FIteration10Levels){
   solver1.setPhis(phis);
 	testRun(testNN, nn_input, target, solver1, helper1, input, true);
 
+}
+
+TEST_F(MGRITSolverTest, FIteration10LevelsParallel){
+
+  const unsigned int max_level = 10;
+	vector<vector<phiFuncType>> phis(max_level, {stateless_phi1});
+  solver1.setMaxLevel(max_level);
+  solver1.setPhis(phis);
+  solver1.setNumThreads(4);
+	testRun(testNN, nn_input, target, solver1, helper1, input, true);
+
 }
\ No newline at end of file
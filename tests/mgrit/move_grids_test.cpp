@@ -67,6 +67,16 @@ void projectTest(const MoveGrids& move, const listOfWeights& input, const listOf
     listOfWeights projected_output = move.project(input, coarse_errors);
     testListOfVectors(projected_output, expected_output);
 
+    // project the weights in place
+    projected_output = input;
+    move.projectInPlace(projected_output, coarse_errors);
+    testListOfVectors(projected_output, expected_output);
+
+    // project onto a grid in place
+    WeightGrid projected_grid(input);
+    move.project(projected_grid, WeightGrid(coarse_errors));
+    testListOfVectors(projected_grid.toList(), expected_output);
+
 }
 
 void restrictTest(const MoveGrids& move, const listOfWeights& input, const listOfWeights& residuals)
@@ -90,6 +100,19 @@ void restrictTest(const MoveGrids& move, const listOfWeights& input, const listO
   testListOfVectors(coarse_grid, expected_output_grid);
   testListOfVectors(coarse_residuals, expected_output_residuals);
 
+  // restrict the grids and ensure the coarse grids are views onto the C-points of the fine grids
+  WeightGrid fine_grid(input);
+  WeightGrid fine_residuals(residuals);
+  WeightGrid coarse_grid_view = move.restrict(fine_grid);
+  WeightGrid coarse_residuals_view = move.restrict(fine_residuals);
+  testListOfVectors(coarse_grid_view.toList(), expected_output_grid);
+  testListOfVectors(coarse_residuals_view.toList(), expected_output_residuals);
+  ASSERT_TRUE(coarse_grid_view.isView()) << "The restricted grid is not a view onto the fine grid";
+  for (int i = 0; i < coarse_grid_view.size(); i++)
+  {
+    ASSERT_EQ(coarse_grid_view.step(i).data(), fine_grid.step(i*m).data()) << "The coarse time step " << i << " does not reference the fine time step " << i*m;
+  }
+
 }
 
 TEST_F(MoveGridsTest, GetCoarseningFactor){
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include "mgrit_helper.h"
+#include "mgrit_solver.h"
+#include "propagator.h"
+#include "relax.h"
+#include "../test_helper.h"
+
+// a concrete propagator that scales the weights of step i by the factor of i modulo the number of factors
+// a StepView reads like a weightType, so one member template serves both kinds of weights
+class ScalingPropagator {
+
+ private:
+
+  vector<double> factors;
+
+ public:
+
+  ScalingPropagator(vector<double> my_factors) : factors{my_factors} {}
+
+  template <typename Weights>
+  void apply(unsigned int i, const Weights& weights, weightType& result) const
+  {
+    result.resize(weights.size());
+    for (unsigned int l = 0; l < weights.size(); l++)
+    {
+      result[l] = factors[i % factors.size()] * weights[l];
+    }
+  }
+
+};
+
+// setup a fixture to use in the tests below
+class PropagatorTest : public testing::Test {
+ 
+ protected:
+
+  const phiFuncType mult_half = [](const weightType& input) 
+  {
+    weightType output = input;
+    for (int i = 0; i < input.size(); i++)
+    {
+        output[i] *= 0.5;
+    }
+    return output;
+  };
+
+  const phiFuncType mult_quarter = [](const weightType& input) 
+  {
+    weightType output = input;
+    for (int i = 0; i < input.size(); i++)
+    {
+        output[i] *= 0.25;
+    }
+    return output;
+  };
+
+  const ScalingPropagator scaling{{0.5, 0.25}};
+  const vector<phiFuncType> phis{mult_half, mult_quarter};
+
+  const unsigned int input_size = 40;
+  weightType test_weights;
+  listOfWeights input;
+  listOfWeights rhs;
+
+  // setup test input to be used
+  void SetUp() override 
+  {
+
+    Matrix<double, 2, 3> test_weights_1;
+    Matrix<double, 3, 1> test_weights_2;
+    test_weights_1 << 4.5, 3, 2,
+                      8, 1, -.5;
+    test_weights_2 << -3, 0.5, 1;
+    test_weights = {test_weights_1, test_weights_2};
+    weightType zeros = {MatrixXd::Zero(2,3), MatrixXd::Zero(3,1)};
+    for (int i = 0; i < input_size; i++)
+    {
+      i % 3 == 0 ? input.push_back(test_weights) : input.push_back(zeros);
+      i == 0 ? rhs.push_back(test_weights) : rhs.push_back(zeros);
+    }
+
+  }
+
+};
+
+TEST_F(PropagatorTest, ApplyPhiFunctions){
+
+    // the type-erased propagator cycles through its phis
+    weightType result;
+    PropagatorTraits<vector<phiFuncType>>::apply(phis, 0, test_weights, result);
+    testVectors(result, mult_half(test_weights));
+    PropagatorTraits<vector<phiFuncType>>::apply(phis, 3, test_weights, result);
+    testVectors(result, mult_quarter(test_weights));
+
+    // a time step of a grid is handed to the phis as a weightType
+    WeightGrid grid(input);
+    PropagatorTraits<vector<phiFuncType>>::apply(phis, 1, grid.stepView(3), result);
+    testVectors(result, mult_quarter(input[3]));
+
+}
+
+TEST_F(PropagatorTest, CountingPropagator){
+
+    // the count is shared between copies and the counted propagator gives the same result
+    CountingPropagator<ScalingPropagator> counted(scaling);
+    CountingPropagator<ScalingPropagator> copy = counted;
+    weightType result;
+    weightType expected_result;
+    for (unsigned int i = 0; i < 5; i++)
+    {
+        copy.apply(i, test_weights, result);
+        scaling.apply(i, test_weights, expected_result);
+        testVectors(result, expected_result);
+    }
+    ASSERT_EQ(counted.getCount(), 5u) << "The propagator was not counted on every application";
+
+}
+
+TEST_F(PropagatorTest, HelperMatchesPhiFunctions){
+
+    // the helper instantiated on a concrete propagator gives the same results as with the equivalent phi functions
+    BasicMGRITHelper<ScalingPropagator> helper(scaling, 2);
+    MGRITHelper erased_helper(phis);
+    testListOfVectors(helper.forwardSolve(rhs), erased_helper.forwardSolve(rhs));
+    testListOfVectors(helper.residual(input, rhs), erased_helper.residual(input, rhs));
+    ASSERT_EQ(helper.residualNorm(WeightGrid(input), WeightGrid(rhs)), erased_helper.residualNorm(WeightGrid(input), WeightGrid(rhs)));
+
+}
+
+TEST_F(PropagatorTest, RelaxMatchesPhiFunctions){
+
+    BasicRelax<ScalingPropagator> relaxer(4, scaling, 2);
+    Relax erased_relaxer(4, phis);
+    testListOfVectors(relaxer.fcfRelax(input, rhs), erased_relaxer.fcfRelax(input, rhs));
+    WeightGrid grid(input);
+    relaxer.fcfRelax(grid, WeightGrid(rhs));
+    testListOfVectors(grid.toList(), erased_relaxer.fcfRelax(input, rhs));
+
+}
+
+TEST_F(PropagatorTest, SolverMatchesPhiFunctions){
+
+    // both solvers take the same path, so the weights and the number of phi applications are the same
+    BasicMGRITSolver<ScalingPropagator> solver(2, {scaling, scaling, scaling}, 3);
+    MGRITSolver erased_solver(2, {phis, phis, phis}, 3);
+    testListOfVectors(solver.run(input, rhs, 1e-10, false), erased_solver.run(input, rhs, 1e-10, false));
+    SolverStats stats = solver.getStats();
+    SolverStats erased_stats = erased_solver.getStats();
+    ASSERT_EQ(stats.iterations, erased_stats.iterations);
+    for (unsigned int l = 0; l < stats.levels.size(); l++)
+    {
+        ASSERT_EQ(stats.levels[l].phi_evaluations, erased_stats.levels[l].phi_evaluations) << "Level " << l << " applied phi a different number of times";
+    }
+
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include "mgrit_helper.h"
 #include "relax.h"
 #include "../test_helper.h"
 
@@ -30,8 +31,12 @@ class RelaxTest : public testing::Test {
     return output;
   };
 
+  const unsigned int num_threads = 4;
+
   Relax relax1{m1, {mult_2}};
   Relax relax2{m2, {mult_3}};
+  Relax parallel_relax1{m1, {mult_2}, num_threads};
+  Relax parallel_relax2{m2, {mult_3}, num_threads};
 
   const unsigned int input_size = 50;
   weightType test_weights;
@@ -101,6 +106,11 @@ void cRelaxTest(const Relax& relax, const listOfWeights& input, const listOfWeig
     listOfWeights relaxed_output = relax.cRelax(input, rhs);
     testListOfVectors(relaxed_output, expected_output);
 
+    // check that relaxing the weights in place gives the same result
+    relaxed_output = input;
+    relax.cRelaxInPlace(relaxed_output, rhs);
+    testListOfVectors(relaxed_output, expected_output);
+
 }
 
 void fcfRelaxTest(const Relax& relax, const listOfWeights& input, const listOfWeights& rhs, const unsigned int& m, const vector<phiFuncType>& phi)
@@ -115,6 +125,11 @@ void fcfRelaxTest(const Relax& relax, const listOfWeights& input, const listOfWe
     listOfWeights relaxed_output = relax.fcfRelax(input, rhs);
     testListOfVectors(relaxed_output, expected_output);
 
+    // check that relaxing the weights in place gives the same result
+    relaxed_output = input;
+    relax.fcfRelaxInPlace(relaxed_output, rhs);
+    testListOfVectors(relaxed_output, expected_output);
+
 }
 
 void fRelaxTest(const Relax& relax, const listOfWeights& input, const listOfWeights& rhs, const unsigned int& m, const vector<phiFuncType>& phi)
@@ -127,6 +142,11 @@ void fRelaxTest(const Relax& relax, const listOfWeights& input, const listOfWeig
     listOfWeights relaxed_output = relax.fRelax(input, rhs);
     testListOfVectors(relaxed_output, expected_output);
 
+    // check that relaxing the weights in place gives the same result
+    relaxed_output = input;
+    relax.fRelaxInPlace(relaxed_output, rhs);
+    testListOfVectors(relaxed_output, expected_output);
+
 }
 
 TEST_F(RelaxTest, CRelax_even){
@@ -141,6 +161,25 @@ TEST_F(RelaxTest, CRelax_odd){
 
 }
 
+TEST_F(RelaxTest, CRelaxParallel_even){
+
+    // the multithreaded C-relaxation must give the expected output of the serial one
+    cRelaxTest(parallel_relax1, input, rhs, m1, {mult_2});
+    WeightGrid grid(input);
+    parallel_relax1.cRelax(grid, WeightGrid(rhs));
+    testListOfVectors(grid.toList(), relax1.cRelax(input, rhs));
+
+}
+
+TEST_F(RelaxTest, CRelaxParallel_odd){
+
+    cRelaxTest(parallel_relax2, input, rhs, m2, {mult_3});
+    WeightGrid grid(input);
+    parallel_relax2.cRelax(grid, WeightGrid(rhs));
+    testListOfVectors(grid.toList(), relax2.cRelax(input, rhs));
+
+}
+
 TEST_F(RelaxTest, FCFRelax_even){
 
     fcfRelaxTest(relax1, input, rhs, m1, {mult_2});
@@ -165,6 +204,108 @@ TEST_F(RelaxTest, FRelax_odd){
 
 }
 
+TEST_F(RelaxTest, GridRelax_even){
+
+    // relaxing a grid in place gives the same result as relaxing the list
+    WeightGrid grid(input);
+    relax1.fcfRelax(grid, WeightGrid(rhs));
+    testListOfVectors(grid.toList(), relax1.fcfRelax(input, rhs));
+
+}
+
+TEST_F(RelaxTest, GridRelax_odd){
+
+    WeightGrid grid(input);
+    parallel_relax2.fcfRelax(grid, WeightGrid(rhs));
+    testListOfVectors(grid.toList(), relax2.fcfRelax(input, rhs));
+
+}
+
+TEST_F(RelaxTest, GridRelaxResidual_even){
+
+    // relax the weights and compute the residual at the C-points from the full residual
+    MGRITHelper helper({mult_2});
+    listOfWeights relaxed_output = relax1.fcfRelax(input, rhs);
+    listOfWeights residuals = helper.residual(relaxed_output, rhs);
+    listOfWeights expected_residuals;
+    for (int i = 0; i < input_size; i += m1)
+    {
+        expected_residuals.push_back(residuals[i]);
+    }
+
+    // the relaxation gives the same C-point residuals without the full residual
+    WeightGrid grid(input);
+    WeightGrid c_residuals(expected_residuals.size(), grid.getLayout());
+    parallel_relax1.fcfRelax(grid, WeightGrid(rhs), c_residuals);
+    testListOfVectors(grid.toList(), relaxed_output);
+    testListOfVectors(c_residuals.toList(), expected_residuals);
+
+}
+
+TEST_F(RelaxTest, GridRelaxResidual_odd){
+
+    MGRITHelper helper({mult_3});
+    listOfWeights relaxed_output = relax2.fRelax(input, rhs);
+    listOfWeights residuals = helper.residual(relaxed_output, rhs);
+    listOfWeights expected_residuals;
+    for (int i = 0; i < input_size; i += m2)
+    {
+        expected_residuals.push_back(residuals[i]);
+    }
+
+    WeightGrid grid(input);
+    WeightGrid c_residuals(expected_residuals.size(), grid.getLayout());
+    relax2.fRelax(grid, WeightGrid(rhs), c_residuals);
+    testListOfVectors(grid.toList(), relaxed_output);
+    testListOfVectors(c_residuals.toList(), expected_residuals);
+
+}
+
+TEST_F(RelaxTest, GridRelaxRange_even){
+
+    // relaxing the C-points and the F-intervals in two ranges, starting with the later one, relaxes all of them
+    WeightGrid grid(input);
+    WeightGrid rhs_grid(rhs);
+    unsigned int num_intervals = (input_size + m1 - 1) / m1;
+    relax1.fRelax(grid, rhs_grid, num_intervals / 2, num_intervals);
+    relax1.fRelax(grid, rhs_grid, 0, num_intervals / 2);
+    testListOfVectors(grid.toList(), relax1.fRelax(input, rhs));
+    relax1.cRelax(grid, rhs_grid, num_intervals / 2, num_intervals);
+    relax1.cRelax(grid, rhs_grid, 0, num_intervals / 2);
+    testListOfVectors(grid.toList(), relax1.cRelax(relax1.fRelax(input, rhs), rhs));
+
+}
+
+TEST_F(RelaxTest, GridRelaxResidualRange_odd){
+
+    // the residual at the first C-point is stored with the first interval, wherever that falls in the order
+    WeightGrid expected_grid(input);
+    WeightGrid expected_residuals((input_size + m2 - 1) / m2, expected_grid.getLayout());
+    relax2.fRelax(expected_grid, WeightGrid(rhs), expected_residuals);
+
+    WeightGrid grid(input);
+    WeightGrid c_residuals(expected_residuals.size(), grid.getLayout());
+    unsigned int num_intervals = expected_residuals.size();
+    relax2.fRelax(grid, WeightGrid(rhs), c_residuals, num_intervals - 1, num_intervals);
+    relax2.fRelax(grid, WeightGrid(rhs), c_residuals, 0, num_intervals - 1);
+    testListOfVectors(grid.toList(), expected_grid.toList());
+    testListOfVectors(c_residuals.toList(), expected_residuals.toList());
+
+}
+
+TEST_F(RelaxTest, FRelaxParallel_even){
+
+    // the multithreaded F-relaxation must be bit-identical to the serial one
+    testListOfVectors(parallel_relax1.fRelax(input, rhs), relax1.fRelax(input, rhs));
+
+}
+
+TEST_F(RelaxTest, FRelaxParallel_odd){
+
+    testListOfVectors(parallel_relax2.fRelax(input, rhs), relax2.fRelax(input, rhs));
+
+}
+
 TEST_F(RelaxTest, GetM) {
 
     unsigned int relax_m = relax1.getM();
@@ -172,6 +313,15 @@ TEST_F(RelaxTest, GetM) {
 
 }
 
+TEST_F(RelaxTest, GetNumThreads) {
+
+    unsigned int relax_threads = relax1.getNumThreads();
+    ASSERT_EQ(relax_threads, 1u) << "The number of threads from the relax class " << relax_threads << " is not equal to 1";
+    relax_threads = parallel_relax1.getNumThreads();
+    ASSERT_EQ(relax_threads, num_threads) << "The number of threads from the relax class " << relax_threads << " is not equal to " << num_threads;
+
+}
+
 TEST_F(RelaxTest, GetPhi){
 
     // test that the output returned from both phi functions is the same
@@ -181,6 +331,18 @@ TEST_F(RelaxTest, GetPhi){
 
 }
 
+TEST_F(RelaxTest, SharedThreadPool){
+
+    // relaxations that share a pool relax like relaxations with pools of their own
+    shared_ptr<ThreadPool> pool = make_shared<ThreadPool>(num_threads);
+    Relax shared_relax1(m1, {mult_2}, pool);
+    Relax shared_relax2(m2, {mult_3}, pool);
+    ASSERT_EQ(shared_relax1.getNumThreads(), num_threads) << "The relax class does not use the threads of the shared pool";
+    testListOfVectors(shared_relax1.fcfRelax(input, rhs), relax1.fcfRelax(input, rhs));
+    testListOfVectors(shared_relax2.fcfRelax(input, rhs), relax2.fcfRelax(input, rhs));
+
+}
+
 TEST_F(RelaxTest, SetM){
     
     // ensure the relax class is initialized properly
@@ -194,6 +356,21 @@ TEST_F(RelaxTest, SetM){
     ASSERT_EQ(relax_m, new_m) << "The new m from the relax class " << relax_m << " is not equal to " << new_m;
 }
 
+TEST_F(RelaxTest, SetNumThreads){
+    
+    // ensure the relax class is initialized properly
+    unsigned int relax_threads = relax1.getNumThreads();
+    ASSERT_EQ(relax_threads, 1u) << "The number of threads from the relax class " << relax_threads << " is not equal to 1";
+    
+    // give the relax class a new number of threads and make sure the relaxation is unchanged
+    listOfWeights serial_output = relax1.fcfRelax(input, rhs);
+    relax1.setNumThreads(num_threads);
+    relax_threads = relax1.getNumThreads();
+    ASSERT_EQ(relax_threads, num_threads) << "The new number of threads from the relax class " << relax_threads << " is not equal to " << num_threads;
+    testListOfVectors(relax1.fcfRelax(input, rhs), serial_output);
+
+}
+
 TEST_F(RelaxTest, SetPhi){
 
     // ensure the relax class is initialized properly
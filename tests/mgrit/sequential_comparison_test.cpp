@@ -0,0 +1,103 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "mgrit_helper.h"
+#include "neural_network.h"
+#include "sequential_comparison.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class SequentialComparisonTest : public testing::Test {
+ 
+ protected:
+
+  const unsigned int m = 2;
+  const unsigned int max_level = 3;
+  const unsigned int input_size = 64;
+
+  listOfWeights input{input_size + 1, {MatrixXd::Zero(3,4), MatrixXd::Zero(4,1)}};
+
+  Matrix<double, 4, 3> nn_input;
+  Matrix<double, 4, 1> target;
+
+  const phiFuncType phi1 = [this](const weightType &weights) 
+  {
+    return NeuralNetwork::propagate(weights, nn_input, target, 1.0);
+  };
+
+  MGRITSolver solver1{m, {max_level, {phi1}}, max_level};
+
+  // setup test input to be used
+  void SetUp() override 
+  {
+
+    // the initial weights are fixed, so the final weights do not depend on which tests ran before
+    Matrix<double, 3, 4> initial_weights_1;
+    Matrix<double, 4, 1> initial_weights_2;
+    initial_weights_1 << 0.5, -0.2, 0.1, 0.8,
+                         -0.7, 0.3, 0.6, -0.4,
+                         0.2, 0.9, -0.5, 0.1;
+    initial_weights_2 << 0.3, -0.6, 0.7, -0.1;
+    input[0] = {initial_weights_1, initial_weights_2};
+
+    // initialize the data for the neural network
+    nn_input << 0.0, 0.0, 1.0,
+                0.0, 1.0, 1.0,
+                1.0, 0.0, 1.0,
+                1.0, 1.0, 1.0;
+
+    target << 0.0,
+              1.0,
+              1.0,
+              0.0;
+
+  }
+
+};
+
+TEST_F(SequentialComparisonTest, CompareToSequential){
+
+    double tol = pow(10, -9) * sqrt(input_size + 1);
+    vector<SequentialComparison> comparisons = compareToSequential(solver1, WeightGrid(input), WeightGrid(input), tol, true, {1, 2});
+
+    // there is one comparison per thread count and MGRIT converges to the sequentially trained weights
+    ASSERT_EQ(comparisons.size(), 2u) << "There is not one comparison per thread count";
+    for (int i = 0; i < comparisons.size(); i++)
+    {
+        ASSERT_EQ(comparisons[i].num_threads, i + 1u) << "Comparison " << i << " has the wrong number of threads";
+        ASSERT_EQ(comparisons[i].sequential_phi_evaluations, input_size) << "The forward solve does not apply one phi per time step";
+        ASSERT_GT(comparisons[i].mgrit_phi_evaluations, input_size) << "MGRIT applied fewer phis than the forward solve";
+        ASSERT_LT(comparisons[i].weight_difference, tol) << "The final weights of MGRIT and the forward solve differ by " << comparisons[i].weight_difference;
+        ASSERT_GT(comparisons[i].speedup(), 0.0) << "The speedup is not positive";
+    }
+    ASSERT_EQ(comparisons[0].sequential_time, comparisons[1].sequential_time) << "The forward solve was timed more than once";
+
+    // the caller's solver keeps its settings
+    ASSERT_EQ(solver1.getNumThreads(), 1u) << "The comparison changed the number of threads of the solver";
+
+}
+
+TEST_F(SequentialComparisonTest, Speedup){
+
+    SequentialComparison comparison;
+    comparison.mgrit_time = 2.0;
+    comparison.sequential_time = 3.0;
+    ASSERT_EQ(comparison.speedup(), 1.5) << "The speedup is not the sequential time over the MGRIT time";
+
+}
+
+TEST_F(SequentialComparisonTest, WriteComparison){
+
+    SequentialComparison comparison;
+    comparison.num_threads = 4;
+    comparison.mgrit_time = 2.0;
+    comparison.sequential_time = 3.0;
+    ostringstream out;
+    writeComparison(out, {comparison, comparison});
+
+    // the report has a header line and one line per thread count
+    string report = out.str();
+    ASSERT_EQ(count(report.begin(), report.end(), '\n'), 3) << "The report does not have a header and one line per comparison";
+    ASSERT_NE(report.find("1.5"), string::npos) << "The report does not show the speedup";
+
+}
\ No newline at end of file
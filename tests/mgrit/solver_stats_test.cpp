@@ -0,0 +1,87 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "solver_stats.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class SolverStatsTest : public testing::Test {
+ 
+ protected:
+
+  SolverStats stats;
+
+  // setup test input to be used
+  void SetUp() override 
+  {
+
+    stats.iterations = 2;
+    stats.residual_norms = {1.0, 0.5, 0.25};
+    stats.convergence_rate = 0.5;
+    stats.total_time = 4.0;
+    stats.levels.resize(2);
+    stats.levels[0].cycles = 2;
+    stats.levels[0].fcf_relax_time = 1.0;
+    stats.levels[0].f_relax_time = 0.5;
+    stats.levels[0].residual_time = 0.25;
+    stats.levels[0].restrict_time = 0.125;
+    stats.levels[0].project_time = 0.125;
+    stats.levels[0].wait_time = 0.0625;
+    stats.levels[0].phi_evaluations = 40;
+    stats.levels[0].bytes_allocated = 800;
+    stats.levels[1].cycles = 2;
+    stats.levels[1].coarse_solve_time = 1.5;
+    stats.levels[1].phi_evaluations = 20;
+
+  }
+
+};
+
+TEST_F(SolverStatsTest, SecondsSince){
+
+    double seconds = secondsSince(statsClock::now());
+    ASSERT_GE(seconds, 0.0) << "The elapsed time " << seconds << " is negative";
+
+}
+
+TEST_F(SolverStatsTest, TotalTime){
+
+    ASSERT_EQ(stats.levels[0].totalTime(), 2.0) << "The phases of the finest level do not add up to 2 seconds";
+    ASSERT_EQ(stats.levels[1].totalTime(), 1.5) << "The phases of the coarsest level do not add up to 1.5 seconds";
+
+}
+
+TEST_F(SolverStatsTest, WriteCSV){
+
+    ostringstream out;
+    stats.writeCSV(out);
+    string expected_output = "level,cycles,fcf_relax_time,f_relax_time,residual_time,restrict_time,coarse_solve_time,project_time,wait_time,phi_evaluations,bytes_allocated\n"
+                             "0,2,1,0.5,0.25,0.125,0,0.125,0.0625,40,800\n"
+                             "1,2,0,0,0,0,1.5,0,0,20,0\n";
+    ASSERT_EQ(out.str(), expected_output) << "The CSV report does not hold one row per level";
+
+}
+
+TEST_F(SolverStatsTest, WriteJSON){
+
+    ostringstream out;
+    stats.writeJSON(out);
+    string expected_output = "{\n"
+                             "  \"iterations\": 2,\n"
+                             "  \"convergence_rate\": 0.5,\n"
+                             "  \"total_time\": 4,\n"
+                             "  \"residual_norms\": [1, 0.5, 0.25],\n"
+                             "  \"levels\": [\n"
+                             "    {\"level\": 0, \"cycles\": 2, \"fcf_relax_time\": 1, \"f_relax_time\": 0.5, \"residual_time\": 0.25, \"restrict_time\": 0.125, \"coarse_solve_time\": 0, \"project_time\": 0.125, \"wait_time\": 0.0625, \"phi_evaluations\": 40, \"bytes_allocated\": 800},\n"
+                             "    {\"level\": 1, \"cycles\": 2, \"fcf_relax_time\": 0, \"f_relax_time\": 0, \"residual_time\": 0, \"restrict_time\": 0, \"coarse_solve_time\": 1.5, \"project_time\": 0, \"wait_time\": 0, \"phi_evaluations\": 20, \"bytes_allocated\": 0}\n"
+                             "  ]\n"
+                             "}\n";
+    ASSERT_EQ(out.str(), expected_output) << "The JSON report is not formatted as expected";
+
+    // a report without levels is still valid JSON
+    SolverStats empty_stats;
+    out.str("");
+    empty_stats.writeJSON(out);
+    ASSERT_NE(out.str().find("\"levels\": []"), string::npos) << "The JSON report of a run without levels has no empty list of levels";
+
+}
\ No newline at end of file
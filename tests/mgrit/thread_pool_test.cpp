@@ -0,0 +1,124 @@
+#include <atomic>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "thread_pool.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class ThreadPoolTest : public testing::Test {
+ 
+ protected:
+
+  const unsigned int num_threads = 4;
+  const unsigned int loop_size = 1000;
+  ThreadPool pool{num_threads};
+
+};
+
+void parallelForTest(ThreadPool& pool, const unsigned int& begin, const unsigned int& end)
+{
+
+    // count how many times each index of the loop is visited
+    vector<int> visits(end, 0);
+    pool.parallelFor(begin, end, [&visits](unsigned int i) { visits[i]++; });
+
+    // construct the expected output
+    vector<int> expected_visits(end, 1);
+    fill(expected_visits.begin(), expected_visits.begin() + begin, 0);
+    testVectors(visits, expected_visits);
+
+}
+
+void parallelForChunksTest(ThreadPool& pool, const unsigned int& begin, const unsigned int& end)
+{
+
+    // count how many times each index of the loop is visited and how many chunks the loop is split into
+    vector<int> visits(end, 0);
+    atomic<unsigned int> num_chunks{0};
+    pool.parallelForChunks(begin, end, [&visits, &num_chunks](unsigned int chunk_begin, unsigned int chunk_end)
+    {
+        num_chunks++;
+        for (unsigned int i = chunk_begin; i < chunk_end; i++) {visits[i]++;}
+    });
+
+    // construct the expected output
+    vector<int> expected_visits(end, 1);
+    fill(expected_visits.begin(), expected_visits.begin() + begin, 0);
+    testVectors(visits, expected_visits);
+    ASSERT_EQ(num_chunks, min(pool.getNumThreads(), end - begin)) << "The loop is not split into one chunk per thread";
+
+}
+
+TEST_F(ThreadPoolTest, GetNumThreads){
+
+    unsigned int pool_threads = pool.getNumThreads();
+    ASSERT_EQ(pool_threads, num_threads) << "The number of threads " << pool_threads << " in the pool is not equal to " << num_threads;
+
+    // a pool can never have fewer threads than the thread calling it
+    ThreadPool empty_pool(0);
+    ASSERT_EQ(empty_pool.getNumThreads(), 1u) << "A pool constructed with 0 threads does not run on the calling thread";
+
+}
+
+TEST_F(ThreadPoolTest, ParallelFor){
+
+    parallelForTest(pool, 0, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForOffset){
+
+    parallelForTest(pool, 17, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForSingleThread){
+
+    ThreadPool serial_pool(1);
+    parallelForTest(serial_pool, 0, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForEmptyRange){
+
+    parallelForTest(pool, loop_size, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForNested){
+
+    // an inner loop run from inside an outer loop on the same pool must still complete
+    atomic<unsigned int> total{0};
+    pool.parallelFor(0, num_threads * 2, [this, &total](unsigned int)
+    {
+        pool.parallelFor(0, loop_size, [&total](unsigned int) { total++; });
+    });
+    ASSERT_EQ(total, num_threads * 2 * loop_size) << "The nested loops did not visit every index exactly once";
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForRethrows){
+
+    // an exception thrown by the loop body is passed on to the calling thread
+    ASSERT_THROW(pool.parallelFor(0, loop_size, [](unsigned int i) { if (i == 500) {throw runtime_error("failed");} }), runtime_error);
+
+    // the pool is still usable after a failed loop
+    parallelForTest(pool, 0, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForChunks){
+
+    parallelForChunksTest(pool, 0, loop_size);
+    parallelForChunksTest(pool, 17, loop_size);
+
+}
+
+TEST_F(ThreadPoolTest, ParallelForChunksSmallRange){
+
+    // a range with fewer indices than threads gives one chunk per index, and an empty range gives none
+    parallelForChunksTest(pool, 0, 3);
+    parallelForChunksTest(pool, loop_size, loop_size);
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "time_slabs.h"
+#include "../test_helper.h"
+
+TEST(TimeSlabsTest, Getters){
+
+    TimeSlabs slabs(101, 2, 4);
+    ASSERT_EQ(slabs.getCoarseningFactor(), 2);
+    ASSERT_EQ(slabs.getNumPoints(), 101);
+    ASSERT_EQ(slabs.getNumSlabs(), 4);
+    ASSERT_EQ(slabs.numIntervals(), 51);
+}
+
+TEST(TimeSlabsTest, SlabsCoverTheGrid){
+
+    // the slabs follow each other without gaps, start at C-points and differ in size by at most one interval
+    for (unsigned int num_slabs = 1; num_slabs <= 7; num_slabs++)
+    {
+        TimeSlabs slabs(101, 3, num_slabs);
+        unsigned int num_coarse_points = 0;
+        ASSERT_EQ(slabs.begin(0), 0);
+        ASSERT_EQ(slabs.end(num_slabs-1), 101);
+        for (unsigned int slab = 0; slab < num_slabs; slab++)
+        {
+            ASSERT_EQ(slabs.begin(slab) % 3, 0);
+            ASSERT_EQ(slabs.coarseBegin(slab), num_coarse_points);
+            ASSERT_LE(slabs.size(slab), 3 * (slabs.numIntervals() / num_slabs + 1));
+            ASSERT_GE(slabs.size(slab) + 3, 3 * (slabs.numIntervals() / num_slabs));
+            if (slab > 0) {ASSERT_EQ(slabs.begin(slab), slabs.end(slab-1));}
+            num_coarse_points += slabs.coarseSize(slab);
+        }
+        ASSERT_EQ(num_coarse_points, 34);
+    }
+}
+
+TEST(TimeSlabsTest, SlabSizes){
+
+    // 11 points with m = 2 form 6 intervals, where the last one only holds its C-point
+    TimeSlabs slabs(11, 2, 4);
+    vector<unsigned int> expected_begins = {0, 2, 6, 8};
+    vector<unsigned int> expected_ends = {2, 6, 8, 11};
+    vector<unsigned int> expected_coarse_sizes = {1, 2, 1, 2};
+    for (unsigned int slab = 0; slab < 4; slab++)
+    {
+        ASSERT_EQ(slabs.begin(slab), expected_begins[slab]);
+        ASSERT_EQ(slabs.end(slab), expected_ends[slab]);
+        ASSERT_EQ(slabs.size(slab), expected_ends[slab] - expected_begins[slab]);
+        ASSERT_EQ(slabs.coarseSize(slab), expected_coarse_sizes[slab]);
+    }
+}
+
+TEST(TimeSlabsTest, MoreSlabsThanIntervals){
+
+    // 5 points with m = 2 form 3 intervals, so one of the 4 slabs stays empty
+    TimeSlabs slabs(5, 2, 4);
+    unsigned int num_empty_slabs = 0;
+    for (unsigned int slab = 0; slab < 4; slab++)
+    {
+        num_empty_slabs += slabs.size(slab) == 0;
+    }
+    ASSERT_EQ(num_empty_slabs, 1);
+    ASSERT_EQ(slabs.end(3), 5);
+}
\ No newline at end of file
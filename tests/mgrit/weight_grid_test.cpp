@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+#include "weight_grid.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class WeightGridTest : public testing::Test {
+ 
+ protected:
+
+  const unsigned int input_size = 20;
+  weightType test_weights;
+  listOfWeights input;
+
+  // setup test input to be used
+  void SetUp() override 
+  {
+
+    Matrix<double, 2, 3> test_weights_1;
+    Matrix<double, 1, 1> test_weights_2;
+    test_weights_1 << 4.5, 3, 2,
+                      8, 1, -.5;
+    test_weights_2 << -3;
+    test_weights = {test_weights_1, test_weights_2};
+
+    // initialize the list of weights that is stored in the grids
+    for (int i = 0; i < input_size; i++)
+    {
+      i % 3 == 0 ? input.push_back(test_weights) : input.push_back({MatrixXd::Random(2,3), MatrixXd::Random(1,1)});
+    }
+
+  }
+
+};
+
+TEST_F(WeightGridTest, AllocatedBytes){
+
+    // a grid owns 7 doubles per time step, while a view owns nothing
+    WeightGrid grid(input);
+    ASSERT_EQ(grid.allocatedBytes(), input_size * 7 * sizeof(double)) << "The grid does not own 7 doubles per time step";
+    ASSERT_EQ(grid.stridedView(3).allocatedBytes(), 0u) << "The view owns storage";
+
+}
+
+TEST_F(WeightGridTest, ConstructFromList){
+
+    // the grid holds every time step of the list and converts back without loss
+    WeightGrid grid(input);
+    ASSERT_EQ(grid.size(), input_size) << "The grid size " << grid.size() << " is not equal to " << input_size;
+    testListOfVectors(grid.toList(), input);
+
+}
+
+TEST_F(WeightGridTest, ConstructZeros){
+
+    WeightGrid grid(input_size, make_shared<const WeightLayout>(test_weights));
+    listOfWeights expected_output(input_size, {MatrixXd::Zero(2,3), MatrixXd::Zero(1,1)});
+    testListOfVectors(grid.toList(), expected_output);
+
+}
+
+TEST_F(WeightGridTest, Contiguous){
+
+    // every layer of every time step sits at a fixed offset inside one buffer
+    WeightGrid grid(input);
+    const double* start = grid.layer(0, 0).data();
+    for (int i = 0; i < input_size; i++)
+    {
+        ASSERT_EQ(grid.layer(i, 0).data(), start + i * 7) << "The first layer of time step " << i << " is not stored contiguously";
+        ASSERT_EQ(grid.layer(i, 1).data(), start + i * 7 + 6) << "The second layer of time step " << i << " is not stored contiguously";
+        ASSERT_EQ(grid.step(i).data(), start + i * 7) << "Time step " << i << " is not stored contiguously";
+    }
+
+}
+
+TEST_F(WeightGridTest, Copy){
+
+    // a copy owns its own data
+    WeightGrid grid(input);
+    WeightGrid copied_grid(grid);
+    copied_grid.layer(0, 1)(0, 0) = 10.0;
+    testListOfVectors(grid.toList(), input);
+    ASSERT_EQ(copied_grid.layer(0, 1)(0, 0), 10.0) << "The copied grid was not modified";
+
+    // assigning a grid also copies its data
+    WeightGrid assigned_grid;
+    assigned_grid = grid;
+    testListOfVectors(assigned_grid.toList(), input);
+
+}
+
+TEST_F(WeightGridTest, CopyStep){
+
+    // copying a step into weights of the right shape reuses their storage
+    WeightGrid grid(input);
+    weightType weights = {MatrixXd::Zero(2,3), MatrixXd::Zero(1,1)};
+    const double* storage = weights[0].data();
+    grid.copyStep(1, weights);
+    testVectors(weights, input[1]);
+    ASSERT_EQ(weights[0].data(), storage) << "Copying a time step reallocated the weights";
+
+}
+
+TEST_F(WeightGridTest, Layout){
+
+    WeightLayout layout(test_weights);
+    ASSERT_EQ(layout.getNumLayers(), 2u) << "The layout does not have 2 layers";
+    ASSERT_EQ(layout.getRows(0), 2) << "The first layer does not have 2 rows";
+    ASSERT_EQ(layout.getCols(0), 3) << "The first layer does not have 3 columns";
+    ASSERT_EQ(layout.getOffset(1), 6) << "The second layer does not start after the first";
+    ASSERT_EQ(layout.getStepSize(), 7) << "A time step does not hold 7 doubles";
+    ASSERT_TRUE(layout == WeightLayout(input[1])) << "Layouts with the same shapes are not equal";
+
+}
+
+TEST_F(WeightGridTest, Move){
+
+    // moving a grid keeps its buffer
+    WeightGrid grid(input);
+    const double* storage = grid.step(0).data();
+    WeightGrid moved_grid(move(grid));
+    ASSERT_EQ(moved_grid.step(0).data(), storage) << "Moving the grid reallocated its data";
+    testListOfVectors(moved_grid.toList(), input);
+
+}
+
+TEST_F(WeightGridTest, StepView){
+
+    // the view reads the layers of a time step in place, also through a strided view of the grid
+    WeightGrid grid(input);
+    StepView view = grid.stepView(1);
+    ASSERT_EQ(view.size(), 2u) << "The view does not have 2 layers";
+    ASSERT_EQ(view[0].data(), grid.layer(1, 0).data()) << "The view does not point into the grid";
+    weightType weights;
+    view.copyTo(weights);
+    testVectors(weights, input[1]);
+    WeightGrid coarse_grid = grid.stridedView(2);
+    coarse_grid.stepView(1).copyTo(weights);
+    testVectors(weights, input[2]);
+
+}
+
+TEST_F(WeightGridTest, StridedView){
+
+    // a view references every third time step of the grid without copying
+    WeightGrid grid(input);
+    WeightGrid view = grid.stridedView(3);
+    listOfWeights expected_output;
+    for (int i = 0; i < input_size; i += 3)
+    {
+        expected_output.push_back(input[i]);
+    }
+    ASSERT_TRUE(view.isView()) << "The strided grid does not reference the original grid";
+    ASSERT_FALSE(grid.isView()) << "The original grid does not own its data";
+    ASSERT_EQ(view.size(), expected_output.size()) << "The view does not hold every third time step";
+    testListOfVectors(view.toList(), expected_output);
+
+    // writing to the view changes the original grid
+    view.layer(1, 1)(0, 0) = 10.0;
+    ASSERT_EQ(grid.layer(3, 1)(0, 0), 10.0) << "Writing to the view did not change the original grid";
+
+    // copying the view produces a contiguous grid that owns its data
+    WeightGrid copied_view = view;
+    ASSERT_FALSE(copied_view.isView()) << "The copy of the view does not own its data";
+    ASSERT_EQ(copied_view.step(1).data(), copied_view.step(0).data() + 7) << "The copy of the view is not contiguous";
+    copied_view.layer(1, 1)(0, 0) = 20.0;
+    ASSERT_EQ(grid.layer(3, 1)(0, 0), 10.0) << "Writing to the copy of the view changed the original grid";
+
+}
+
+TEST_F(WeightGridTest, SetStep){
+
+    WeightGrid grid(input);
+    grid.setStep(1, test_weights);
+    testVectors(grid.getStep(1), test_weights);
+
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include <mpi.h>
+
+#include "gtest/gtest.h"
+
+// runs the tests on every process, where only process 0 prints the results
+int main(int argc, char **argv) 
+{
+    MPI_Init(&argc, &argv);
+    testing::InitGoogleTest(&argc, argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0)
+    {
+        delete testing::UnitTest::GetInstance()->listeners().Release(testing::UnitTest::GetInstance()->listeners().default_result_printer());
+    }
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+#include "fixed_neural_network.h"
+#include "mgrit_solver.h"
+#include "neural_network.h"
+#include "phi_generator.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class FixedNeuralNetworkTest : public testing::Test {
+ 
+ protected:
+
+  const float alpha = 2.0;
+  const MatrixXd random1 = MatrixXd::Random(3,4);
+  const MatrixXd random2 = MatrixXd::Random(4,1);
+  const weightType weights = {random1, random2};
+
+  FixedNeuralNetwork<3, 4, 1> nn1{alpha, weights};
+
+};
+
+// the fixed-size kernels may round differently from the dynamic ones, so the weights are only compared approximately
+void testApproxWeights(const weightType& actual_weights, const weightType& expected_weights)
+{
+    ASSERT_EQ(actual_weights.size(), expected_weights.size()) << "The weights have a different number of layers";
+    for (int l = 0; l < actual_weights.size(); l++)
+    {
+        ASSERT_EQ(actual_weights[l].rows(), expected_weights[l].rows()) << "Layer " << l << " has the wrong number of rows";
+        ASSERT_EQ(actual_weights[l].cols(), expected_weights[l].cols()) << "Layer " << l << " has the wrong number of columns";
+        ASSERT_TRUE(actual_weights[l].isApprox(expected_weights[l], 1e-12)) << "The weights differ at layer " << l;
+    }
+}
+
+TEST_F(FixedNeuralNetworkTest, GetAlpha){
+
+    float nn_alpha = nn1.getAlpha();
+    ASSERT_EQ(nn_alpha, alpha) << "The NN alpha " << nn_alpha << " is not equal to " << alpha;
+
+}
+
+TEST_F(FixedNeuralNetworkTest, GetWeights){
+
+    weightType nn_weights = nn1.getWeights();
+    testVectors(nn_weights, weights);
+
+}
+
+TEST_F(FixedNeuralNetworkTest, LargeLayers){
+
+    // layers too large for fixed-size matrices fall back to dynamic storage and still train like the dynamic nn
+    weightType large_weights = {MatrixXd::Random(24,128), MatrixXd::Random(128,64), MatrixXd::Random(64,12)};
+    MatrixXd input = MatrixXd::Random(8,24);
+    MatrixXd target = MatrixXd::Random(8,12);
+    weightType new_weights = FixedNeuralNetwork<24, 128, 64, 12>::propagate(large_weights, input, target, 0.5);
+    testApproxWeights(new_weights, NeuralNetwork::propagate(large_weights, input, target, 0.5));
+
+}
+
+TEST_F(FixedNeuralNetworkTest, Propagate){
+
+    // propagating the weights trains them like the dynamic nn without changing the state of any nn
+    MatrixXd input = MatrixXd::Random(10,3);
+    MatrixXd target = MatrixXd::Ones(10,1);
+    weightType new_weights = FixedNeuralNetwork<3, 4, 1>::propagate(weights, input, target, alpha);
+    testApproxWeights(new_weights, NeuralNetwork::propagate(weights, input, target, alpha));
+    testVectors(nn1.getWeights(), weights);
+
+}
+
+TEST_F(FixedNeuralNetworkTest, PropagateInPlace){
+
+    // the weights are trained in the storage of the caller and give the same weights as training the nn itself
+    MatrixXd input = MatrixXd::Random(10,3);
+    MatrixXd target = MatrixXd::Ones(10,1);
+    weightType new_weights = weights;
+    const double* storage = new_weights[0].data();
+    FixedNeuralNetwork<3, 4, 1>::propagateInPlace(new_weights, input, target, alpha);
+    ASSERT_EQ(new_weights[0].data(), storage) << "Propagating the weights in place reallocated them";
+    nn1.train(input, target);
+    testVectors(new_weights, nn1.getWeights());
+
+}
+
+TEST_F(FixedNeuralNetworkTest, RunMGRIT){
+
+    // phis built from the fixed nn plug into the solver and give the same weights as phis built from the dynamic nn
+    MatrixXd input(4,3);
+    input << 0.0, 0.0, 1.0,
+             0.0, 1.0, 1.0,
+             1.0, 0.0, 1.0,
+             1.0, 1.0, 1.0;
+    MatrixXd target(4,1);
+    target << 0.0, 1.0, 1.0, 0.0;
+    listOfWeights initial_weights(33, {MatrixXd::Zero(3,4), MatrixXd::Zero(4,1)});
+    initial_weights[0] = weights;
+
+    MGRITSolver fixed_solver(2, generatePhis(input, target, 1.0, 4.0, 3, 1, FixedNeuralNetwork<3, 4, 1>::propagate), 3);
+    MGRITSolver dynamic_solver(2, generatePhis(input, target, 1.0, 4.0, 3, 1), 3);
+    listOfWeights fixed_weights = fixed_solver.run(initial_weights, initial_weights, 1e-9, true);
+    listOfWeights dynamic_weights = dynamic_solver.run(initial_weights, initial_weights, 1e-9, true);
+    for (int i = 0; i < fixed_weights.size(); i++)
+    {
+        testApproxWeights(fixed_weights[i], dynamic_weights[i]);
+    }
+
+}
+
+TEST_F(FixedNeuralNetworkTest, SetAlpha){
+
+    float new_alpha = 5.0;
+    nn1.setAlpha(new_alpha);
+    ASSERT_EQ(nn1.getAlpha(), new_alpha) << "The NN alpha " << nn1.getAlpha() << " is not equal to " << new_alpha;
+
+}
+
+TEST_F(FixedNeuralNetworkTest, SetWeights){
+
+    weightType new_weights = {MatrixXd::Random(3,4), MatrixXd::Random(4,1)};
+    nn1.setWeights(new_weights);
+    testVectors(nn1.getWeights(), new_weights);
+
+}
+
+TEST_F(FixedNeuralNetworkTest, Train){
+
+    // training repeatedly on a single row matches the dynamic nn
+    MatrixXd input = MatrixXd::Random(1,3);
+    MatrixXd target = MatrixXd::Ones(1,1);
+    NeuralNetwork expected_nn{alpha, weights};
+    for (int i = 0; i < 5; i++)
+    {
+        nn1.train(input, target);
+        expected_nn.train(input, target);
+    }
+    testApproxWeights(nn1.getWeights(), expected_nn.getWeights());
+
+}
+
+TEST_F(FixedNeuralNetworkTest, WrongWeights){
+
+    // weights that do not match the layer sizes are rejected instead of being read out of bounds
+    MatrixXd input = MatrixXd::Random(10,3);
+    MatrixXd target = MatrixXd::Ones(10,1);
+    weightType missing_layer = {random1};
+    weightType transposed_layer = {random1, random2.transpose()};
+    typedef FixedNeuralNetwork<3, 4, 1> Network;
+    ASSERT_THROW(Network(alpha, missing_layer), invalid_argument) << "A nn with a missing layer was accepted";
+    ASSERT_THROW(nn1.setWeights(transposed_layer), invalid_argument) << "Weights of the wrong shape were set";
+    ASSERT_THROW(Network::propagate(missing_layer, input, target, alpha), invalid_argument) << "Weights with a missing layer were propagated";
+    ASSERT_THROW(Network::propagateInPlace(transposed_layer, input, target, alpha), invalid_argument) << "Weights of the wrong shape were propagated";
+    testVectors(nn1.getWeights(), weights);
+
+}
\ No newline at end of file
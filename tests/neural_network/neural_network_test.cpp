@@ -30,6 +30,46 @@ TEST_F(NeuralNetworkTest, GetWeights){
 
 }
 
+TEST_F(NeuralNetworkTest, Propagate){
+
+    // train a copy of the nn to get the expected weights
+    MatrixXd input = MatrixXd::Ones(10,3);
+    MatrixXd target = MatrixXd::Ones(10,1);
+    NeuralNetwork expected_nn{alpha, weights};
+    expected_nn.train(input, target);
+
+    // propagating the weights gives the same result without changing the state of any nn
+    weightType new_weights = NeuralNetwork::propagate(weights, input, target, alpha);
+    testVectors(new_weights, expected_nn.getWeights());
+    testVectors(nn1.getWeights(), weights);
+
+}
+
+TEST_F(NeuralNetworkTest, PropagateWithWorkspace){
+
+    MatrixXd input = MatrixXd::Random(10,3);
+    MatrixXd target = MatrixXd::Ones(10,1);
+    NetworkWorkspace workspace;
+
+    // the weights are trained in place and a reused workspace gives the same result as a fresh one
+    weightType new_weights = weights;
+    const double* storage = new_weights[0].data();
+    for (int i = 0; i < 3; i++)
+    {
+        nn1.train(input, target);
+        NeuralNetwork::propagate(new_weights, input, target, alpha, workspace);
+        testVectors(new_weights, nn1.getWeights());
+    }
+    ASSERT_EQ(new_weights[0].data(), storage) << "Training with a workspace reallocated the weights";
+
+    // the same workspace can be used for a different number of input rows
+    weightType row_weights = NeuralNetwork::propagate(weights, input.row(0), target.row(0), alpha);
+    new_weights = weights;
+    NeuralNetwork::propagate(new_weights, input.row(0), target.row(0), alpha, workspace);
+    testVectors(new_weights, row_weights);
+
+}
+
 TEST_F(NeuralNetworkTest, SetAlpha){
     
     // ensure the nn is initialized properly
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "neural_network.h"
+#include "phi_generator.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class PhiGeneratorTest : public testing::Test {
+ 
+ protected:
+
+  const float base_alpha = 0.5;
+  const float max_alpha = 1.5;
+  const unsigned int max_level = 4;
+  const MatrixXd input = MatrixXd::Random(10,3);
+  const MatrixXd target = MatrixXd::Random(10,1);
+  const weightType weights = {MatrixXd::Random(3,4), MatrixXd::Random(4,1)};
+
+};
+
+void generatePhisTest(const vector<vector<phiFuncType>>& phis, const MatrixXd& input, const MatrixXd& target, const weightType& weights, const vector<float>& alphas, const unsigned int& batch_size)
+{
+
+    ASSERT_EQ(phis.size(), alphas.size()) << "There is not one list of phis for each level";
+    for (int i = 0; i < phis.size(); i++)
+    {
+        // every level has one phi per mini-batch, which trains the nn on that batch with the learning rate of the level
+        ASSERT_EQ(phis[i].size(), numMiniBatches(input, batch_size)) << "Level " << i << " does not have one phi per mini-batch";
+        for (int j = 0; j < phis[i].size(); j++)
+        {
+            weightType expected_weights = NeuralNetwork::propagate(weights, miniBatch(input, j, batch_size), miniBatch(target, j, batch_size), alphas[i]);
+            testVectors(phis[i][j](weights), expected_weights);
+        }
+    }
+
+}
+
+TEST_F(PhiGeneratorTest, GeneratePhisBatch){
+
+    generatePhisTest(generatePhis(input, target, base_alpha, max_alpha, max_level, 10), input, target, weights, {0.5, 1.0, 1.5, 1.5}, 10);
+
+}
+
+TEST_F(PhiGeneratorTest, GeneratePhisMiniBatch){
+
+    generatePhisTest(generatePhis(input, target, base_alpha, max_alpha, max_level, 4), input, target, weights, {0.5, 1.0, 1.5, 1.5}, 4);
+
+}
+
+TEST_F(PhiGeneratorTest, GeneratePhisSerialized){
+
+    generatePhisTest(generatePhis(input, target, base_alpha, max_alpha, max_level, 1), input, target, weights, {0.5, 1.0, 1.5, 1.5}, 1);
+
+}
+
+TEST_F(PhiGeneratorTest, MiniBatch){
+
+    // the batches hold consecutive rows and the last batch holds the remaining rows
+    MatrixXd batch = miniBatch(input, 1, 4);
+    ASSERT_EQ(batch, input.middleRows(4, 4)) << "The second mini-batch does not hold rows 4 to 7";
+    batch = miniBatch(input, 2, 4);
+    ASSERT_EQ(batch, input.middleRows(8, 2)) << "The last mini-batch does not hold the remaining rows";
+    batch = miniBatch(input, 0, 20);
+    ASSERT_EQ(batch, input) << "A mini-batch larger than the data set does not hold the whole data set";
+
+}
+
+TEST_F(PhiGeneratorTest, NumMiniBatches){
+
+    ASSERT_EQ(numMiniBatches(input, 1), 10u) << "A batch size of 1 does not give one batch per row";
+    ASSERT_EQ(numMiniBatches(input, 4), 3u) << "A batch size of 4 does not give 3 batches for 10 rows";
+    ASSERT_EQ(numMiniBatches(input, 10), 1u) << "A batch size of 10 does not give a single batch";
+    ASSERT_EQ(numMiniBatches(input, 20), 1u) << "A batch size larger than the data set does not give a single batch";
+
+}
+
+TEST_F(PhiGeneratorTest, GeneratePropagators){
+
+    // the propagators apply the same phis as generatePhis
+    vector<vector<phiFuncType>> phis = generatePhis(input, target, base_alpha, max_alpha, max_level, 4);
+    vector<TrainingPropagator<NeuralNetwork>> propagators = generatePropagators<NeuralNetwork>(input, target, base_alpha, max_alpha, max_level, 4);
+    ASSERT_EQ(propagators.size(), phis.size()) << "There is not one propagator for each level";
+    weightType result;
+    for (int i = 0; i < propagators.size(); i++)
+    {
+        ASSERT_EQ(propagators[i].size(), phis[i].size()) << "The propagator of level " << i << " does not have one phi per mini-batch";
+        for (int j = 0; j < phis[i].size(); j++)
+        {
+            propagators[i].apply(j, weights, result);
+            testVectors(result, phis[i][j](weights));
+        }
+    }
+
+}
+
+TEST_F(PhiGeneratorTest, LevelAlpha){
+
+    // the learning rate doubles on each level up to the maximum
+    ASSERT_EQ(levelAlpha(base_alpha, max_alpha, 0), 0.5f) << "The finest level does not use the base learning rate";
+    ASSERT_EQ(levelAlpha(base_alpha, max_alpha, 1), 1.0f) << "The learning rate does not double on the next level";
+    ASSERT_EQ(levelAlpha(base_alpha, max_alpha, 3), 1.5f) << "The learning rate is not capped at the maximum";
+
+}
\ No newline at end of file
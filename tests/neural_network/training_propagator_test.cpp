@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "fixed_neural_network.h"
+#include "mgrit_solver.h"
+#include "neural_network.h"
+#include "phi_generator.h"
+#include "training_propagator.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class TrainingPropagatorTest : public testing::Test {
+ 
+ protected:
+
+  const float alpha = 0.5;
+  const MatrixXd input = MatrixXd::Random(10,3);
+  const MatrixXd target = MatrixXd::Random(10,1);
+  const weightType weights = {MatrixXd::Random(3,4), MatrixXd::Random(4,1)};
+  const vector<MatrixXd> batch_inputs = {input.topRows(6), input.bottomRows(4)};
+  const vector<MatrixXd> batch_targets = {target.topRows(6), target.bottomRows(4)};
+
+};
+
+TEST_F(TrainingPropagatorTest, Apply){
+
+    // step i trains the weights on mini-batch i modulo the number of batches
+    TrainingPropagator<NeuralNetwork> propagator(alpha, batch_inputs, batch_targets);
+    weightType result;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        propagator.apply(i, weights, result);
+        testVectors(result, NeuralNetwork::propagate(weights, batch_inputs[i % 2], batch_targets[i % 2], alpha));
+    }
+
+}
+
+TEST_F(TrainingPropagatorTest, ApplyFixed){
+
+    // the fixed-size nn trains exactly like the nn of dynamic size
+    TrainingPropagator<FixedNeuralNetwork<3, 4, 1>> fixed_propagator(alpha, batch_inputs, batch_targets);
+    TrainingPropagator<NeuralNetwork> propagator(alpha, batch_inputs, batch_targets);
+    weightType fixed_result;
+    weightType result;
+    fixed_propagator.apply(1, weights, fixed_result);
+    propagator.apply(1, weights, result);
+    testVectors(fixed_result, result);
+
+}
+
+TEST_F(TrainingPropagatorTest, GetAlpha){
+
+    TrainingPropagator<NeuralNetwork> propagator(alpha, batch_inputs, batch_targets);
+    ASSERT_EQ(propagator.getAlpha(), alpha) << "The learning rate of the propagator " << propagator.getAlpha() << " is not equal to " << alpha;
+    ASSERT_EQ(propagator.size(), 2u) << "The propagator does not have one phi per mini-batch";
+
+}
+
+TEST_F(TrainingPropagatorTest, SolverMatchesPhiFunctions){
+
+    // the solver instantiated on the propagators converges to the same weights as the solver with the generated phis
+    listOfWeights initial_weights(33, {MatrixXd::Zero(3,4), MatrixXd::Zero(4,1)});
+    initial_weights[0] = weights;
+    MGRITSolver solver(2, generatePhis(input, target, alpha, 1.0, 3, 4), 3);
+    BasicMGRITSolver<TrainingPropagator<FixedNeuralNetwork<3, 4, 1>>> fixed_solver(2, generatePropagators<FixedNeuralNetwork<3, 4, 1>>(input, target, alpha, 1.0, 3, 4), 3, false, 2);
+    testListOfVectors(fixed_solver.run(initial_weights, initial_weights, 1e-9, true), solver.run(initial_weights, initial_weights, 1e-9, true));
+
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "datasets.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class DatasetsTest : public testing::Test {
+ 
+ protected:
+
+  const string data_path = "datasets_test.csv";
+
+  void TearDown() override 
+  {
+    remove(data_path.c_str());
+  }
+
+};
+
+TEST_F(DatasetsTest, BinaryAdditionData){
+
+    // the target of each row is the binary sum of the two numbers in the input, modulo 2^bits
+    vector<MatrixXd> data = binaryAdditionData(4, 20);
+    ASSERT_EQ(data[0].rows(), 20) << "The input does not have one row per sample";
+    ASSERT_EQ(data[0].cols(), 8) << "The input does not hold two 4 bit numbers";
+    ASSERT_EQ(data[1].cols(), 4) << "The target does not hold a 4 bit number";
+    for (int i = 0; i < 20; i++)
+    {
+        unsigned int number_1 = 0, number_2 = 0, total = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            number_1 = 2 * number_1 + data[0](i, j);
+            number_2 = 2 * number_2 + data[0](i, 4 + j);
+            total = 2 * total + data[1](i, j);
+        }
+        ASSERT_EQ(total, (number_1 + number_2) % 16) << "Row " << i << " does not hold the sum of its inputs";
+    }
+
+    // the same seed gives the same data
+    ASSERT_EQ(binaryAdditionData(4, 20)[0], data[0]) << "The data is not reproducible";
+
+}
+
+TEST_F(DatasetsTest, LoadDataset){
+
+    vector<MatrixXd> data = loadDataset("xor", {3, 4, 1});
+    ASSERT_EQ(data[0], xorData()[0]) << "The xor dataset was not loaded";
+    data = loadDataset("binary_addition", {24, 128, 64, 12});
+    ASSERT_EQ(data[0], binaryAdditionData()[0]) << "The binary addition dataset was not loaded";
+    ASSERT_THROW(loadDataset("xor", {2, 4, 1}), invalid_argument) << "A dataset that does not fit the nn was accepted";
+
+}
+
+TEST_F(DatasetsTest, RandomWeights){
+
+    weightType weights = randomWeights({24, 128, 64, 12});
+    ASSERT_EQ(weights.size(), 3u) << "The nn does not have one weight matrix per pair of layers";
+    ASSERT_EQ(weights[1].rows(), 128) << "The second weight matrix has the wrong number of rows";
+    ASSERT_EQ(weights[1].cols(), 64) << "The second weight matrix has the wrong number of columns";
+
+}
+
+TEST_F(DatasetsTest, ReadCSVData){
+
+    ofstream file(data_path);
+    file << "0,1,0.5\n" << "1,0,-2\n" << "\n";
+    file.close();
+    vector<MatrixXd> data = readCSVData(data_path, 2);
+    Matrix<double, 2, 2> expected_input;
+    expected_input << 0, 1, 
+                      1, 0;
+    Matrix<double, 2, 1> expected_target;
+    expected_target << 0.5, -2;
+    ASSERT_EQ(data[0], expected_input) << "The inputs were not read";
+    ASSERT_EQ(data[1], expected_target) << "The targets were not read";
+    ASSERT_THROW(readCSVData(data_path, 3), invalid_argument) << "A dataset without targets was accepted";
+    ASSERT_THROW(readCSVData("missing.csv", 2), invalid_argument) << "A missing dataset was accepted";
+
+}
+
+TEST_F(DatasetsTest, XorData){
+
+    vector<MatrixXd> data = xorData();
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(data[1](i, 0), double(int(data[0](i, 0)) ^ int(data[0](i, 1)))) << "Row " << i << " does not hold the xor of its inputs";
+        ASSERT_EQ(data[0](i, 2), 1.0) << "The bias input of row " << i << " is not 1";
+    }
+
+}
\ No newline at end of file
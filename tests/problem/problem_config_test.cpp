@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "problem_config.h"
+#include "../test_helper.h"
+
+// setup a fixture to use in the tests below
+class ProblemConfigTest : public testing::Test {
+ 
+ protected:
+
+  ProblemConfig config;
+  const string config_path = "problem_config_test.cfg";
+
+  void TearDown() override 
+  {
+    remove(config_path.c_str());
+  }
+
+};
+
+ProblemConfig parse(vector<string> arguments)
+{
+    vector<char*> argv;
+    arguments.insert(arguments.begin(), "mgrit_problem");
+    for (string& argument : arguments)
+    {
+        argv.push_back(&argument[0]);
+    }
+    return parseArguments(argv.size(), argv.data());
+}
+
+TEST_F(ProblemConfigTest, ApplySetting){
+
+    applySetting(config, "N", "50");
+    applySetting(config, "alpha_b", "0.5");
+    applySetting(config, "f_cycles", "false");
+    applySetting(config, "layers", "2, 5, 3");
+    applySetting(config, "comparison_threads", "1,4");
+    applySetting(config, "dataset", "data.csv");
+    applySetting(config, "max_coarse_size", "16");
+    applySetting(config, "pipeline_coarse_solve", "0");
+    ASSERT_EQ(config.N, 50u) << "The number of training steps was not set";
+    ASSERT_EQ(config.alpha_b, 0.5) << "The learning rate was not set";
+    ASSERT_FALSE(config.f_cycles) << "The cycle type was not set";
+    testVectors(config.layers, {2, 5, 3});
+    testVectors(config.comparison_threads, {1, 4});
+    ASSERT_EQ(config.dataset, "data.csv") << "The dataset was not set";
+    ASSERT_EQ(config.max_coarse_size, 16u) << "The size of the coarsest grid was not set";
+    ASSERT_FALSE(config.pipeline_coarse_solve) << "The pipelining of the coarse solve was not set";
+
+}
+
+TEST_F(ProblemConfigTest, InvalidSettings){
+
+    ASSERT_THROW(applySetting(config, "unknown", "1"), invalid_argument) << "An unknown setting was accepted";
+    ASSERT_THROW(applySetting(config, "N", "ten"), invalid_argument) << "A setting that is not a number was accepted";
+    ASSERT_THROW(applySetting(config, "N", "-5"), invalid_argument) << "A negative number of training steps was accepted";
+    ASSERT_THROW(applySetting(config, "f_cycles", "maybe"), invalid_argument) << "A setting that is not a boolean was accepted";
+    ASSERT_THROW(applySetting(config, "m", "1"), invalid_argument) << "A coarsening factor of 1 was accepted";
+    ASSERT_THROW(applySetting(config, "m", "4294967298"), invalid_argument) << "A number too large for an unsigned int was accepted";
+    ASSERT_THROW(applySetting(config, "comparison_threads", "1,4294967296"), invalid_argument) << "A list entry too large for an unsigned int was accepted";
+    ASSERT_THROW(applySetting(config, "comparison_threads", "0,2"), invalid_argument) << "A comparison on 0 threads was accepted";
+    ASSERT_THROW(applySetting(config, "layers", "3"), invalid_argument) << "A nn without weights was accepted";
+    ASSERT_THROW(parse({"N=5"}), invalid_argument) << "A setting without leading dashes was accepted";
+    ASSERT_THROW(parse({"--N"}), invalid_argument) << "A setting without a value was accepted";
+
+}
+
+TEST_F(ProblemConfigTest, ParseArguments){
+
+    // both --key=value and --key value are accepted and the other settings keep their defaults
+    config = parse({"--N=20", "--max_level", "3", "--num_threads=4"});
+    ASSERT_EQ(config.N, 20u) << "The number of training steps was not parsed";
+    ASSERT_EQ(config.max_level, 3u) << "The max level was not parsed";
+    ASSERT_EQ(config.num_threads, 4u) << "The number of threads was not parsed";
+    ASSERT_EQ(config.m, 2u) << "The coarsening factor does not keep its default";
+
+}
+
+TEST_F(ProblemConfigTest, ParseArgumentsOrder){
+
+    // the preset and the config file are applied first, whatever their position on the command line
+    ofstream file(config_path);
+    file << "# a comment\n" << "N = 30  # training steps\n" << "\n" << "max_level = 4\n";
+    file.close();
+    config = parse({"--max_level=6", "--config=" + config_path, "--problem=four_layer"});
+    ASSERT_EQ(config.N, 30u) << "The config file was not read";
+    ASSERT_EQ(config.max_level, 6u) << "The command line does not override the config file";
+    ASSERT_EQ(config.dataset, "binary_addition") << "The preset was not applied";
+
+}
+
+TEST_F(ProblemConfigTest, ProblemPreset){
+
+    config = problemPreset("four_layer");
+    testVectors(config.layers, {24, 128, 64, 12});
+    ASSERT_EQ(config.alpha_b, 0.025f) << "The four layer problem has the wrong learning rate";
+    ASSERT_FALSE(config.print_weights) << "The four layer problem prints its weights";
+    config = problemPreset("three_layer");
+    testVectors(config.layers, {3, 4, 1});
+    ASSERT_THROW(problemPreset("five_layer"), invalid_argument) << "An unknown problem was accepted";
+
+}
+
+TEST_F(ProblemConfigTest, ReadConfigFile){
+
+    ofstream file(config_path);
+    file << "problem = four_layer\n" << "batch_size = 10\n" << "display_output = 0\n";
+    file.close();
+    readConfigFile(config, config_path);
+    ASSERT_EQ(config.batch_size, 10u) << "The batch size was not read";
+    ASSERT_FALSE(config.display_output) << "The display flag was not read";
+    ASSERT_EQ(config.dataset, "binary_addition") << "The preset in the config file was not applied";
+    ASSERT_THROW(readConfigFile(config, "missing.cfg"), invalid_argument) << "A missing config file was accepted";
+
+}
\ No newline at end of file